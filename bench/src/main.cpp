@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+#include "MyVector.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /*
+        Benchmark push_back latency
+        Prints the push_back latency distribution of a large heap buffer grown in one step
+        (Vector) and incrementally (IncrementalVector with the given step)
+    */
+    template <typename V>
+    void measurePushBack(V& vec, size_t count)
+    {
+        mylib::Vector<long long> latencies(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Clock::time_point start = Clock::now();
+            vec.push_back(static_cast<long long>(i));
+            latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << "p50 " << latencies[count / 2] << " ns, p99 " << latencies[count - count / 100]
+            << " ns, p99.9 " << latencies[count - count / 1000] << " ns, max " << latencies.back() / 1000 << " us";
+    }
+
+    void benchGrowthLatency(size_t count)
+    {
+        const size_t threshold = mylib::memory::hugePageThreshold();
+        mylib::memory::setHugePageThreshold(0);  // Heap buffers, so growth relocates elements
+
+        std::cout << "push_back latency (" << count << " push_backs)\n  one-step growth:          ";
+        {
+            mylib::Vector<long long> vec;
+            measurePushBack(vec, count);
+        }
+        for (size_t step : { 1, 16, 64 })
+        {
+            std::cout << "\n  incremental growth, step " << step << ": ";
+            mylib::IncrementalVector<long long> vec;
+            vec.setIncrementalGrowth(step);
+            measurePushBack(vec, count);
+        }
+        std::cout << std::endl;
+
+        mylib::memory::setHugePageThreshold(threshold);
+    }
+}
+
+int main()
+{
+    benchGrowthLatency(size_t(1) << 22);
+    return 0;
+}
@@ -69,18 +69,18 @@ namespace mylib {
         template <typename T>
         void merge(T* begin, T* mid, T* end)
         {
-            unsigned int n1 = mid - begin;
-            unsigned int n2 = end - mid;
+            size_t n1 = mid - begin;
+            size_t n2 = end - mid;
 
             T* left = new T[n1];
             T* right = new T[n2];
 
-            for (unsigned int i = 0; i < n1; ++i)
+            for (size_t i = 0; i < n1; ++i)
                 left[i] = *(begin + i);
-            for (unsigned int j = 0; j < n2; ++j)
+            for (size_t j = 0; j < n2; ++j)
                 right[j] = *(mid + j);
 
-            unsigned int i = 0, j = 0, k = 0;
+            size_t i = 0, j = 0, k = 0;
             while (i < n1 && j < n2)
             {
                 if (left[i] <= right[j])
@@ -1,10 +1,32 @@
 #ifndef MYLIB_ARRAY_H
 #define MYLIB_ARRAY_H
 
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include "MyBulk.h"
+#include "MyConfig.h"
+#include "MyIterator.h"
+#include "MyMemory.h"
+
 namespace mylib
 {
     /**
      * Generic Array class representing a dynamic array.
+     * Storage is allocated raw and elements are constructed in place. Trivial element
+     * types on the global heap live in malloc'd memory: zeroed arrays come from calloc
+     * (large blocks get lazily zeroed pages from the OS) and resize uses realloc, which
+     * can grow large blocks by remapping pages instead of copying. Buffers above the
+     * huge-page threshold are mapped on 2 MB huge pages when the system allows it.
+     * mapFile() creates an array backed directly by a binary file.
+     * An optional std::pmr::memory_resource routes all storage elsewhere (see MyMemory.h).
      * @tparam T The type of elements stored in the array.
      */
     template <typename T>
@@ -12,39 +34,271 @@ namespace mylib
     private:
         T* m_data;   ///< Pointer to the array data.
         size_t m_size;   ///< Size of the array.
+        std::pmr::memory_resource* m_resource;   ///< Resource owning the storage, or nullptr for the global heap.
+        memory::PageBacking m_backing;   ///< How the current storage is backed.
+
+        /// True if elements can be copied bytewise and need no construction or destruction.
+        static constexpr bool kTrivial = std::is_trivially_copyable_v<T>
+            && std::is_trivially_default_constructible_v<T>;
+
+        /// True if heap storage comes from malloc/calloc/realloc.
+        bool usesCHeap() const
+        {
+            return kTrivial && !m_resource && alignof(T) <= alignof(std::max_align_t);
+        }
+
+        /**
+         * Allocates raw storage for count elements.
+         * @param count The number of elements.
+         * @param zeroed True to zero the memory (honoured for trivial types only).
+         * @param backing Receives how the storage is backed.
+         * @return The storage, or nullptr if count is 0.
+         * @throws std::bad_alloc if the allocation fails.
+         */
+        T* allocate(size_t count, bool zeroed, memory::PageBacking& backing) const
+        {
+            backing = memory::PageBacking::Heap;
+            if (count == 0)
+                return nullptr;
+            if (count > static_cast<size_t>(-1) / sizeof(T))
+                throw std::bad_alloc();
+            const size_t bytes = count * sizeof(T);
+            if (!m_resource && memory::wantsHugePages(bytes))
+            {
+                if (void* mapped = memory::mapHugePages(bytes, backing))
+                    return static_cast<T*>(mapped);  ///< Fresh mappings are already zeroed.
+            }
+            if (usesCHeap())
+            {
+                void* memory = zeroed ? std::calloc(count, sizeof(T)) : std::malloc(bytes);
+                if (!memory)
+                    throw std::bad_alloc();
+                return static_cast<T*>(memory);
+            }
+            T* data = memory::allocateArray<T>(m_resource, count);
+            if (kTrivial && zeroed)
+                std::memset(static_cast<void*>(data), 0, bytes);
+            return data;
+        }
+
+        /**
+         * Frees storage from allocate() without destroying elements.
+         */
+        void deallocate(T* data, size_t count, memory::PageBacking backing) const
+        {
+            if (backing == memory::PageBacking::FileReadOnly || backing == memory::PageBacking::FileCopyOnWrite)
+                memory::unmapFile(data, count * sizeof(T));
+            else if (backing != memory::PageBacking::Heap)
+                memory::unmapHugePages(data, count * sizeof(T));
+            else if (usesCHeap())
+                std::free(data);
+            else
+                memory::deallocateArray(m_resource, data, count);
+        }
+
+        /**
+         * Destroys count elements and releases their storage.
+         */
+        void release(T* data, size_t count, memory::PageBacking backing) const
+        {
+            if (!data)
+                return;
+            if constexpr (!kTrivial)
+                std::destroy_n(data, count);
+            deallocate(data, count, backing);
+        }
+
+        /**
+         * Allocates count elements into m_data, value-initialized (zeroed) or default-initialized.
+         */
+        void create(size_t count, bool zeroed)
+        {
+            T* data = allocate(count, zeroed, m_backing);
+            if constexpr (!kTrivial)
+            {
+                try
+                {
+                    if (zeroed)
+                        std::uninitialized_value_construct_n(data, count);
+                    else
+                        std::uninitialized_default_construct_n(data, count);
+                }
+                catch (...)
+                {
+                    deallocate(data, count, m_backing);
+                    throw;
+                }
+            }
+            m_data = data;
+        }
+
+        /**
+         * Allocates a copy of count elements into m_data.
+         */
+        void duplicate(const T* source, size_t count)
+        {
+            T* data = allocate(count, false, m_backing);
+            if constexpr (kTrivial)
+            {
+                bulk::copy(source, data, count);
+            }
+            else
+            {
+                try
+                {
+                    std::uninitialized_copy_n(source, count, data);
+                }
+                catch (...)
+                {
+                    deallocate(data, count, m_backing);
+                    throw;
+                }
+            }
+            m_data = data;
+        }
+
+        /**
+         * Copies a read-only file mapping into regular storage so the elements can be written.
+         * Every accessor that hands out writable elements calls this first.
+         */
+        void makeWritable()
+        {
+            if (m_backing != memory::PageBacking::FileReadOnly) [[likely]]
+                return;
+            Array copy(*this, m_resource);
+            swap(copy);
+        }
+
+        /**
+         * Changes the size, keeping the common prefix and initializing any new tail.
+         * @param newSize The new size.
+         * @param zeroed True to value-initialize new elements, false to default-initialize them.
+         */
+        void resizeStorage(size_t newSize, bool zeroed)
+        {
+            if (newSize == m_size)
+                return;
+            if (newSize == 0)
+            {
+                clear();
+                return;
+            }
+            if (newSize > static_cast<size_t>(-1) / sizeof(T))
+                throw std::bad_alloc();
+            if constexpr (kTrivial && memory::kTriviallyRelocatable<T>)  // realloc moves the bytes
+            {
+                if (usesCHeap() && m_backing == memory::PageBacking::Heap && !memory::wantsHugePages(newSize * sizeof(T)))
+                {
+                    void* memory = std::realloc(m_data, newSize * sizeof(T));
+                    if (!memory)
+                        throw std::bad_alloc();
+                    m_data = static_cast<T*>(memory);
+                    if (zeroed && newSize > m_size)
+                        std::memset(static_cast<void*>(m_data + m_size), 0, (newSize - m_size) * sizeof(T));
+                    m_size = newSize;
+                    return;
+                }
+            }
+
+            memory::PageBacking newBacking;
+            T* newData = allocate(newSize, false, newBacking);
+            const size_t kept = m_size < newSize ? m_size : newSize;
+            size_t constructed = 0;
+            try
+            {
+                if constexpr (kTrivial)
+                {
+                    bulk::copy(m_data, newData, kept);
+                    if (zeroed && newSize > kept && newBacking == memory::PageBacking::Heap)
+                        std::memset(static_cast<void*>(newData + kept), 0, (newSize - kept) * sizeof(T));
+                }
+                else
+                {
+                    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                        std::uninitialized_move_n(m_data, kept, newData);
+                    else
+                        std::uninitialized_copy_n(m_data, kept, newData);
+                    constructed = kept;
+                    if (zeroed)
+                        std::uninitialized_value_construct_n(newData + kept, newSize - kept);
+                    else
+                        std::uninitialized_default_construct_n(newData + kept, newSize - kept);
+                }
+            }
+            catch (...)
+            {
+                if constexpr (!kTrivial)
+                    std::destroy_n(newData, constructed);
+                deallocate(newData, newSize, newBacking);
+                throw;
+            }
+            release(m_data, m_size, m_backing);
+            m_data = newData;
+            m_size = newSize;
+            m_backing = newBacking;
+        }
 
     public:
         /**
          * Default constructor.
          * Initializes an empty array with no allocated memory.
          */
-        Array() : m_data(nullptr), m_size(0) {}
+        Array() : m_data(nullptr), m_size(0), m_resource(nullptr), m_backing(memory::PageBacking::Heap) {}
 
         /**
          * Constructor with specified size.
          * Allocates memory for an array of the given size and initializes all elements to zero.
          * @param size The size of the array.
+         * @param resource The memory resource for the storage, or nullptr for the global heap.
+         */
+        explicit Array(size_t size, std::pmr::memory_resource* resource = nullptr)
+            : m_data(nullptr), m_size(size), m_resource(resource), m_backing(memory::PageBacking::Heap)
+        {
+            create(size, true);
+        }
+
+        /**
+         * Constructor with specified size that skips zeroing.
+         * Elements are default-initialized, so trivial types hold indeterminate values
+         * until written.
+         * @param size The size of the array.
+         * @param resource The memory resource for the storage, or nullptr for the global heap.
          */
-        explicit Array(size_t size) : m_size(size)
+        Array(size_t size, Uninitialized, std::pmr::memory_resource* resource = nullptr)
+            : m_data(nullptr), m_size(size), m_resource(resource), m_backing(memory::PageBacking::Heap)
         {
-            m_data = new T[size]();  ///< Dynamically allocate memory for the array and initialize to zero.
+            create(size, false);
         }
 
         /**
          * Copy constructor.
          * Creates a new Array instance by copying elements from another array.
          * @param other The other array to copy from.
+         * @param resource The memory resource for the copy, or nullptr for the global heap.
          */
-        Array(const Array& other) : m_data(new T[other.m_size]), m_size(other.m_size)
+        Array(const Array& other, std::pmr::memory_resource* resource = nullptr)
+            : m_data(nullptr), m_size(other.m_size), m_resource(resource), m_backing(memory::PageBacking::Heap)
         {
-            for (size_t i = 0; i < m_size; ++i)
-                m_data[i] = other.m_data[i];  ///< Copy elements one by one.
+            duplicate(other.m_data, other.m_size);
+        }
+
+        /**
+         * Move constructor.
+         * Takes over the storage (and its memory resource) of another array, leaving it empty.
+         * @param other The other array to move from.
+         */
+        Array(Array&& other) noexcept
+            : m_data(other.m_data), m_size(other.m_size), m_resource(other.m_resource), m_backing(other.m_backing)
+        {
+            other.m_data = nullptr;
+            other.m_size = 0;
+            other.m_backing = memory::PageBacking::Heap;
         }
 
         /**
          * Copy assignment operator.
          * Allows copying the contents of one array to another.
-         * Frees the previously allocated memory before assigning the new array.
+         * The copy is allocated from this array's memory resource.
          * @param other The other array to copy from.
          * @return A reference to the current object after the assignment.
          */
@@ -52,51 +306,153 @@ namespace mylib
         {
             if (this != &other)
             {
-                T* newData = new T[other.m_size];  ///< Allocate memory for a new array.
-                for (size_t i = 0; i < other.m_size; ++i)
-                    newData[i] = other.m_data[i];  ///< Copy elements.
-
-                delete[] m_data;  ///< Free the memory of the old array.
-                m_data = newData;  ///< Point to the new array.
-                m_size = other.m_size;  ///< Update the size.
+                Array copy(other, m_resource);  ///< Copy first so a throwing copy leaves this array intact.
+                swap(copy);
             }
             return *this;  ///< Return the current object to allow chained assignments.
         }
 
+        /**
+         * Move assignment operator.
+         * Frees the current storage and takes over the storage (and memory resource) of another array.
+         * @param other The other array to move from.
+         * @return A reference to the current object after the assignment.
+         */
+        Array& operator=(Array&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Array moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+
         /**
          * Destructor.
-         * Frees the memory allocated for the array.
+         * Destroys the elements and frees the memory allocated for the array.
          */
         ~Array()
         {
-            delete[] m_data;
+            release(m_data, m_size, m_backing);
+        }
+
+        /**
+         * Creates an array backed by a memory-mapped binary file holding raw elements.
+         * No data is read up front: pages fault in on first access and are shared with
+         * other processes mapping the same file. Resizing copies the data to regular storage.
+         * @param path The file to map.
+         * @param mode ReadOnly (the first writable access copies the elements to regular
+         *             storage) or CopyOnWrite (written pages become private; the file never changes).
+         * @return The array; a trailing partial element in the file is ignored.
+         * @throws "Cannot map file" if the file cannot be opened or mapped.
+         */
+        static Array mapFile(const std::string& path, memory::FileMapping mode = memory::FileMapping::ReadOnly)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be mapped from a file");
+            Array result;
+            size_t count = 0;
+            result.m_data = static_cast<T*>(memory::mapFile(path, mode, sizeof(T), count));
+            result.m_size = count;
+            if (result.m_data)
+                result.m_backing = mode == memory::FileMapping::ReadOnly
+                    ? memory::PageBacking::FileReadOnly : memory::PageBacking::FileCopyOnWrite;
+            return result;
+        }
+
+        /**
+         * Writes the raw elements to a binary file that mapFile() can load.
+         * @param path The file to write.
+         * @throws "Cannot write file" if the file cannot be written.
+         */
+        void writeToFile(const std::string& path) const
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be written to a file");
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out)
+                throw "Cannot write file";
+            out.write(reinterpret_cast<const char*>(m_data), static_cast<std::streamsize>(m_size * sizeof(T)));
+            if (!out)
+                throw "Cannot write file";
+        }
+
+        /**
+         * Checks whether the elements are still a read-only file mapping.
+         * Non-const access (operator[], at, fill, begin, ...) copies them out first.
+         * @return True if the storage is read-only.
+         */
+        bool isReadOnly() const
+        {
+            return m_backing == memory::PageBacking::FileReadOnly;
+        }
+
+        /**
+         * Gets the memory resource that owns the storage.
+         * @return The resource, or nullptr for the global heap.
+         */
+        std::pmr::memory_resource* resource() const
+        {
+            return m_resource;
+        }
+
+        /**
+         * Gets how the storage is backed, e.g. whether it ended up on huge pages.
+         * @return The page backing of the current storage.
+         */
+        memory::PageBacking pageBacking() const
+        {
+            return m_backing;
         }
 
         /**
          * Accessor for an element in the array (read/write access).
-         * Throws an exception if the index is out of bounds.
+         * The index is only checked when MYLIB_BOUNDS_CHECK is enabled (debug builds).
          * @param index The index of the element.
          * @return A reference to the element at the specified index.
-         * @throws "Index out of range" if the index is invalid.
+         * @throws "Index out of range" if checking is enabled and the index is invalid.
          */
         T& operator[](size_t index)
         {
-            if (index >= m_size)
-                throw "Index out of range";  ///< Checks if the index is valid.
+            detail::checkIndex(index, m_size);
+            makeWritable();
             return m_data[index];
         }
 
         /**
          * Accessor for an element in the array (read-only access).
-         * Throws an exception if the index is out of bounds.
+         * The index is only checked when MYLIB_BOUNDS_CHECK is enabled (debug builds).
          * @param index The index of the element.
          * @return A constant reference to the element at the specified index.
-         * @throws "Index out of range" if the index is invalid.
+         * @throws "Index out of range" if checking is enabled and the index is invalid.
          */
         const T& operator[](size_t index) const
         {
-            if (index >= m_size)
-                throw "Index out of range";  ///< Checks if the index is valid.
+            detail::checkIndex(index, m_size);
+            return m_data[index];
+        }
+
+        /**
+         * Accessor for an element in the array, always bounds-checked.
+         * @param index The index of the element.
+         * @return A reference to the element at the specified index.
+         * @throws "Index out of range" if the index is invalid.
+         */
+        T& at(size_t index)
+        {
+            detail::checkIndexAlways(index, m_size);
+            makeWritable();
+            return m_data[index];
+        }
+
+        /**
+         * Read-only accessor for an element in the array, always bounds-checked.
+         * @param index The index of the element.
+         * @return A constant reference to the element at the specified index.
+         * @throws "Index out of range" if the index is invalid.
+         */
+        const T& at(size_t index) const
+        {
+            detail::checkIndexAlways(index, m_size);
             return m_data[index];
         }
 
@@ -111,22 +467,22 @@ namespace mylib
 
         /**
          * Resizes the array.
-         * Allocates a new array with the new size and copies the old elements.
+         * Existing elements are kept up to the new size and new elements are zeroed.
          * @param newSize The new size of the array.
          */
         void resize(size_t newSize)
         {
-            if (newSize == m_size) return;  ///< If the size doesn't change, do nothing.
-
-            T* newData = new T[newSize];  ///< Allocate memory for a new array.
-            size_t minSize = (m_size < newSize) ? m_size : newSize;  ///< Determine the smaller size for copying.
-
-            for (size_t i = 0; i < minSize; ++i)
-                newData[i] = m_data[i];  ///< Copy existing elements.
+            resizeStorage(newSize, true);
+        }
 
-            delete[] m_data;  ///< Free the old memory.
-            m_data = newData;  ///< Point to the new array.
-            m_size = newSize;  ///< Update the size.
+        /**
+         * Resizes the array without zeroing the new elements.
+         * New elements are default-initialized, so trivial types hold indeterminate values.
+         * @param newSize The new size of the array.
+         */
+        void resize(size_t newSize, Uninitialized)
+        {
+            resizeStorage(newSize, false);
         }
 
         /**
@@ -135,19 +491,21 @@ namespace mylib
          */
         void clear()
         {
-            delete[] m_data;
+            release(m_data, m_size, m_backing);
             m_data = nullptr;
             m_size = 0;
+            m_backing = memory::PageBacking::Heap;
         }
 
         /**
          * Fills the array with a specific value.
+         * Large arrays of trivially copyable elements are filled by several threads.
          * @param value The value to assign to all elements in the array.
          */
         void fill(const T& value)
         {
-            for (size_t i = 0; i < m_size; ++i)
-                m_data[i] = value;  ///< Set each element to the specified value.
+            makeWritable();
+            bulk::fill(m_data, m_size, value);
         }
 
         /**
@@ -158,9 +516,10 @@ namespace mylib
          */
         void assign(size_t count, const T& value)
         {
-            resize(count);
-            for (size_t i = 0; i < count; ++i)
-                m_data[i] = value;  ///< Assign the value to each element.
+            const T copy = value;  // value may be an element of this array
+            resize(count, uninitialized);
+            makeWritable();
+            bulk::fill(m_data, count, copy);
         }
 
         /**
@@ -173,6 +532,7 @@ namespace mylib
         {
             if (m_size == 0)
                 throw "Array is empty";
+            makeWritable();
             return m_data[0];
         }
 
@@ -186,6 +546,7 @@ namespace mylib
         {
             if (m_size == 0)
                 throw "Array is empty";
+            makeWritable();
             return m_data[m_size - 1];
         }
 
@@ -194,6 +555,16 @@ namespace mylib
          * @return A pointer to the data array.
          */
         T* dataPointer()
+        {
+            makeWritable();
+            return m_data;
+        }
+
+        /**
+         * Gets a read-only pointer to the underlying data of the array.
+         * @return A constant pointer to the data array.
+         */
+        const T* dataPointer() const
         {
             return m_data;
         }
@@ -209,16 +580,23 @@ namespace mylib
 
         /**
          * Swaps the contents of this array with another.
+         * Each array's memory resource travels with its storage.
          * @param other The array to swap with.
          */
         void swap(Array& other)
         {
             T* tempData = m_data;
             size_t tempSize = m_size;
+            std::pmr::memory_resource* tempResource = m_resource;
+            memory::PageBacking tempBacking = m_backing;
             m_data = other.m_data;
             m_size = other.m_size;
+            m_resource = other.m_resource;
+            m_backing = other.m_backing;
             other.m_data = tempData;
             other.m_size = tempSize;
+            other.m_resource = tempResource;
+            other.m_backing = tempBacking;
         }
 
         /**
@@ -227,6 +605,7 @@ namespace mylib
          */
         T* begin()
         {
+            makeWritable();
             return m_data;
         }
 
@@ -235,31 +614,73 @@ namespace mylib
          * @return A pointer to the end position (one past the last element).
          */
         T* end()
+        {
+            makeWritable();
+            return m_data + m_size;
+        }
+
+        /**
+         * Gets a pointer to the first element of the array (const version).
+         * Pointers are contiguous iterators, so the standard algorithms run directly on arrays.
+         * @return A pointer to the first element.
+         */
+        const T* begin() const
+        {
+            return m_data;
+        }
+
+        /**
+         * Gets a pointer to one past the last element of the array (const version).
+         * @return A pointer to the end position (one past the last element).
+         */
+        const T* end() const
         {
             return m_data + m_size;
         }
 
         /**
-         * Gets a pointer to the last element of the array.
-         * @return A pointer to the last element.
+         * Gets a reverse iterator at the last element of the array; advance it with operator--.
+         * @return A reverse iterator at the last element.
          */
-        T* rbegin()
+        ContiguousReverseIterator<T> rbegin()
         {
-            return m_data + m_size - 1;
+            makeWritable();
+            return ContiguousReverseIterator<T>(m_data + m_size);
         }
 
         /**
-         * Gets a pointer to one before the first element of the array.
-         * @return A pointer to the reverse end position (one before the first element).
+         * Gets the reverse end position (past the first element).
+         * @return A reverse iterator marking the end of a reverse traversal.
          */
-        T* rend()
+        ContiguousReverseIterator<T> rend()
         {
-            return m_data - 1;
+            makeWritable();
+            return ContiguousReverseIterator<T>(m_data);
+        }
+
+        /**
+         * Gets a reverse iterator at the last element of the array (const version).
+         * @return A reverse iterator at the last element.
+         */
+        ContiguousReverseIterator<const T> rbegin() const
+        {
+            return ContiguousReverseIterator<const T>(m_data + m_size);
+        }
+
+        /**
+         * Gets the reverse end position (const version).
+         * @return A reverse iterator marking the end of a reverse traversal.
+         */
+        ContiguousReverseIterator<const T> rend() const
+        {
+            return ContiguousReverseIterator<const T>(m_data);
         }
     };
 
     /**
      * Compares two arrays for equality.
+     * Integral elements are compared with memcmp, floating-point ones with SIMD compares,
+     * and large arrays by several threads.
      * @param lhs The first array.
      * @param rhs The second array.
      * @return True if the arrays are equal, otherwise false.
@@ -269,12 +690,7 @@ namespace mylib
     {
         if (lhs.getSize() != rhs.getSize())
             return false;
-        for (size_t i = 0; i < lhs.getSize(); ++i)
-        {
-            if (lhs[i] != rhs[i])
-                return false;
-        }
-        return true;
+        return bulk::equal(lhs.dataPointer(), rhs.dataPointer(), lhs.getSize());
     }
 
     /**
@@ -291,6 +707,7 @@ namespace mylib
 
     /**
      * Compares two arrays to determine if the first is less than the second.
+     * The arrays are ordered at the first position where their elements differ, found with SIMD compares.
      * @param lhs The first array.
      * @param rhs The second array.
      * @return True if the first array is less than the second, otherwise false.
@@ -298,15 +715,7 @@ namespace mylib
     template <typename T>
     bool operator<(const Array<T>& lhs, const Array<T>& rhs)
     {
-        size_t minSize = (lhs.getSize() < rhs.getSize()) ? lhs.getSize() : rhs.getSize();
-        for (size_t i = 0; i < minSize; ++i)
-        {
-            if (lhs[i] < rhs[i])
-                return true;
-            if (lhs[i] > rhs[i])
-                return false;
-        }
-        return lhs.getSize() < rhs.getSize();
+        return simd::lexicographicLess(lhs.dataPointer(), lhs.getSize(), rhs.dataPointer(), rhs.getSize());
     }
 
     /**
@@ -345,6 +754,10 @@ namespace mylib
         return !(lhs < rhs);
     }
 
+    // An Array owns its elements only through a pointer, so it can be relocated with memcpy.
+    template <typename T>
+    struct memory::IsTriviallyRelocatable<Array<T>> : std::true_type {};
+
 } // namespace mylib
 
 #endif // MYLIB_ARRAY_H
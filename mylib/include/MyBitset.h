@@ -0,0 +1,616 @@
+#ifndef MYLIB_BITSET_H
+#define MYLIB_BITSET_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "MyBulk.h"
+#include "MyConfig.h"
+#include "MyMemory.h"
+#include "MyParallel.h"
+#include "MySimd.h"
+
+namespace mylib
+{
+    // Resizable sequence of bits packed 64 to a word, with the Vector interface where it makes
+    // sense (push_back, resize, reserve, at, operator[]...). Whole-bitset operations (and, or,
+    // xor, not, count, find) work a word at a time with SSE2 and hardware popcount, and are
+    // split across worker threads for very large bitsets. The bits past size() in the last
+    // word are always zero. Storage comes from an optional std::pmr::memory_resource.
+    class DynamicBitset {
+    public:
+        using Word = uint64_t;
+
+        // Number of bits per storage word.
+        static constexpr size_t bitsPerWord = 64;
+
+        // Proxy returned by the non-const operator[], reading and writing a single bit.
+        class Reference {
+        public:
+            Reference(Word* word, Word mask) : m_word(word), m_mask(mask) {}
+
+            operator bool() const
+            {
+                return (*m_word & m_mask) != 0;
+            }
+
+            Reference& operator=(bool value)
+            {
+                if (value)
+                    *m_word |= m_mask;
+                else
+                    *m_word &= ~m_mask;
+                return *this;
+            }
+
+            Reference& operator=(const Reference& other)
+            {
+                return *this = static_cast<bool>(other);
+            }
+
+            // Inverts the bit.
+            void flip()
+            {
+                *m_word ^= m_mask;
+            }
+
+        private:
+            Word* m_word; // The word holding the bit.
+            Word m_mask;  // The bit within the word.
+        };
+
+        // Default constructor initializes an empty bitset with no allocated memory.
+        // Param: resource - The memory resource for the storage, or nullptr for the global heap.
+        explicit DynamicBitset(std::pmr::memory_resource* resource = nullptr)
+            : m_words(nullptr), m_size(0), m_capacity(0), m_resource(resource) {}
+
+        // Constructor with an initial size.
+        // Param: size - The number of bits.
+        // Param: value - The value of every bit.
+        // Param: resource - The memory resource for the storage, or nullptr for the global heap.
+        explicit DynamicBitset(size_t size, bool value = false, std::pmr::memory_resource* resource = nullptr)
+            : DynamicBitset(resource)
+        {
+            resize(size, value);
+        }
+
+        // Copy constructor.
+        // Param: other - The bitset to copy from.
+        // Param: resource - The memory resource for the copy, or nullptr for the global heap.
+        DynamicBitset(const DynamicBitset& other, std::pmr::memory_resource* resource = nullptr)
+            : DynamicBitset(resource)
+        {
+            reallocate(wordsFor(other.m_size));
+            bulk::copy(other.m_words, m_words, wordsFor(other.m_size));
+            m_size = other.m_size;
+        }
+
+        // Move constructor. Takes over the storage (and memory resource) of another bitset.
+        // Param: other - The bitset to move from (left empty).
+        DynamicBitset(DynamicBitset&& other) noexcept
+            : m_words(other.m_words), m_size(other.m_size), m_capacity(other.m_capacity), m_resource(other.m_resource)
+        {
+            other.m_words = nullptr;
+            other.m_size = 0;
+            other.m_capacity = 0;
+        }
+
+        // Assignment operator. The copy is allocated from this bitset's memory resource.
+        // Param: other - The bitset to copy from.
+        // Returns: A reference to this bitset after copying.
+        DynamicBitset& operator=(const DynamicBitset& other)
+        {
+            if (this != &other)
+            {
+                DynamicBitset copy(other, m_resource);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        // Move assignment operator. Takes over the storage (and memory resource) of another bitset.
+        // Param: other - The bitset to move from (left empty).
+        // Returns: A reference to this bitset after moving.
+        DynamicBitset& operator=(DynamicBitset&& other) noexcept
+        {
+            if (this != &other)
+            {
+                DynamicBitset moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+
+        // Destructor to deallocate the storage.
+        ~DynamicBitset()
+        {
+            memory::deallocateArray(m_resource, m_words, m_capacity);
+        }
+
+        // Returns the memory resource that owns the storage (nullptr for the global heap).
+        std::pmr::memory_resource* resource() const
+        {
+            return m_resource;
+        }
+
+        // Swaps the content (and memory resource) of this bitset with another bitset.
+        // Param: other - The bitset to swap with.
+        void swap(DynamicBitset& other) noexcept
+        {
+            std::swap(m_words, other.m_words);
+            std::swap(m_size, other.m_size);
+            std::swap(m_capacity, other.m_capacity);
+            std::swap(m_resource, other.m_resource);
+        }
+
+        // Adds a bit to the end of the bitset, doubling the storage if necessary.
+        // Param: value - The value of the new bit.
+        void push_back(bool value)
+        {
+            if (m_size == m_capacity * bitsPerWord)
+            {
+                if (m_size == max_size())
+                    throw std::bad_alloc();
+                reallocate(m_capacity == 0 ? 1 : m_capacity * 2);
+            }
+            if (m_size % bitsPerWord == 0)
+                m_words[m_size / bitsPerWord] = 0;
+            if (value)
+                m_words[m_size / bitsPerWord] |= Word(1) << (m_size % bitsPerWord);
+            ++m_size;
+        }
+
+        // Removes the last bit of the bitset.
+        void pop_back()
+        {
+            if (m_size == 0)
+                return;
+            --m_size;
+            m_words[m_size / bitsPerWord] &= ~(Word(1) << (m_size % bitsPerWord));
+        }
+
+        // Resizes the bitset, setting new bits to a value.
+        // Param: newSize - The new number of bits.
+        // Param: value - The value of the bits added past the old size.
+        void resize(size_t newSize, bool value = false)
+        {
+            if (newSize > max_size())
+                throw std::bad_alloc();
+            if (newSize <= m_size)
+            {
+                m_size = newSize;
+                clearTail();
+                return;
+            }
+            const size_t newWords = wordsFor(newSize);
+            if (newWords > m_capacity)
+                reallocate(newWords > m_capacity * 2 ? newWords : m_capacity * 2);
+            const size_t oldWords = wordsFor(m_size);
+            bulk::fill(m_words + oldWords, newWords - oldWords, Word(0));
+            const size_t oldSize = m_size;
+            m_size = newSize;
+            if (value)
+                setRange(oldSize, newSize);
+        }
+
+        // Reserves storage for at least a number of bits.
+        // Param: bits - The number of bits to reserve.
+        void reserve(size_t bits)
+        {
+            if (bits > max_size())
+                throw std::bad_alloc();
+            if (wordsFor(bits) > m_capacity)
+                reallocate(wordsFor(bits));
+        }
+
+        // Reduces the storage to the words holding bits.
+        void shrink_to_fit()
+        {
+            if (wordsFor(m_size) != m_capacity)
+                reallocate(wordsFor(m_size));
+        }
+
+        // Removes every bit; the storage is kept.
+        void clear()
+        {
+            m_size = 0;
+        }
+
+        // Returns the number of bits in the bitset.
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        // Returns the number of bits the storage can hold.
+        size_t capacity() const
+        {
+            return m_capacity * bitsPerWord;
+        }
+
+        // Returns the largest number of bits the bitset can address.
+        size_t max_size() const
+        {
+            return std::numeric_limits<size_t>::max() / sizeof(Word);
+        }
+
+        // Checks if the bitset is empty.
+        // Returns: true if the bitset has no bits, false otherwise.
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        // Returns the number of storage words holding bits.
+        size_t wordCount() const
+        {
+            return wordsFor(m_size);
+        }
+
+        // Returns a pointer to the storage words; bit i is bit i % 64 of word i / 64.
+        const Word* data() const
+        {
+            return m_words;
+        }
+
+        // Reads a bit.
+        // The index is only checked when MYLIB_BOUNDS_CHECK is enabled (debug builds).
+        // Param: index - The index of the bit.
+        // Returns: The value of the bit.
+        bool operator[](size_t index) const
+        {
+            detail::checkIndex(index, m_size);
+            return (m_words[index / bitsPerWord] >> (index % bitsPerWord)) & 1;
+        }
+
+        // Accesses a bit for reading or writing.
+        // The index is only checked when MYLIB_BOUNDS_CHECK is enabled (debug builds).
+        // Param: index - The index of the bit.
+        // Returns: A proxy for the bit.
+        Reference operator[](size_t index)
+        {
+            detail::checkIndex(index, m_size);
+            return Reference(m_words + index / bitsPerWord, Word(1) << (index % bitsPerWord));
+        }
+
+        // Reads a bit with bounds checking.
+        // Param: index - The index of the bit.
+        // Returns: The value of the bit.
+        // Throws: "Index out of range" if the index is invalid.
+        bool at(size_t index) const
+        {
+            detail::checkIndexAlways(index, m_size);
+            return (*this)[index];
+        }
+
+        // Accesses a bit with bounds checking.
+        // Param: index - The index of the bit.
+        // Returns: A proxy for the bit.
+        // Throws: "Index out of range" if the index is invalid.
+        Reference at(size_t index)
+        {
+            detail::checkIndexAlways(index, m_size);
+            return (*this)[index];
+        }
+
+        // Reads a bit with bounds checking (same as at).
+        bool test(size_t index) const
+        {
+            return at(index);
+        }
+
+        // Sets a bit to a value.
+        // Param: index - The index of the bit.
+        // Param: value - The new value.
+        // Throws: "Index out of range" if the index is invalid.
+        void set(size_t index, bool value = true)
+        {
+            at(index) = value;
+        }
+
+        // Clears a bit.
+        // Param: index - The index of the bit.
+        // Throws: "Index out of range" if the index is invalid.
+        void reset(size_t index)
+        {
+            at(index) = false;
+        }
+
+        // Inverts a bit.
+        // Param: index - The index of the bit.
+        // Throws: "Index out of range" if the index is invalid.
+        void flip(size_t index)
+        {
+            at(index).flip();
+        }
+
+        // Sets the bits in the index range [first, last) to a value. Whole words in the middle
+        // of the range are filled with memset.
+        // Param: first - The index of the first bit.
+        // Param: last - The index past the last bit.
+        // Param: value - The new value.
+        // Throws: "Index out of range" if last is greater than the size.
+        void setRange(size_t first, size_t last, bool value = true)
+        {
+            if (last > m_size)
+                detail::indexOutOfRange(last, m_size);
+            if (first >= last)
+                return;
+            const size_t firstWord = first / bitsPerWord;
+            const size_t lastWord = (last - 1) / bitsPerWord;
+            const Word head = ~Word(0) << (first % bitsPerWord);
+            const Word tail = ~Word(0) >> (bitsPerWord - 1 - (last - 1) % bitsPerWord);
+            if (firstWord == lastWord)
+            {
+                applyMask(firstWord, head & tail, value);
+                return;
+            }
+            applyMask(firstWord, head, value);
+            bulk::fill(m_words + firstWord + 1, lastWord - firstWord - 1, value ? ~Word(0) : Word(0));
+            applyMask(lastWord, tail, value);
+        }
+
+        // Clears the bits in the index range [first, last).
+        // Param: first - The index of the first bit.
+        // Param: last - The index past the last bit.
+        // Throws: "Index out of range" if last is greater than the size.
+        void resetRange(size_t first, size_t last)
+        {
+            setRange(first, last, false);
+        }
+
+        // Sets every bit.
+        void set()
+        {
+            bulk::fill(m_words, wordCount(), ~Word(0));
+            clearTail();
+        }
+
+        // Clears every bit.
+        void reset()
+        {
+            bulk::fill(m_words, wordCount(), Word(0));
+        }
+
+        // Inverts every bit.
+        void flip()
+        {
+            forWords([this](size_t begin, size_t end)
+            {
+                simd::invertWords(m_words + begin, end - begin);
+            });
+            clearTail();
+        }
+
+        // Counts the set bits with hardware popcount.
+        // Returns: The number of set bits.
+        size_t count() const
+        {
+            const size_t words = wordCount();
+            if (words < 2 * kParallelWords)
+                return simd::popcountWords(m_words, words);
+            std::atomic<size_t> total{ 0 };
+            forWords([&](size_t begin, size_t end)
+            {
+                total.fetch_add(simd::popcountWords(m_words + begin, end - begin), std::memory_order_relaxed);
+            });
+            return total.load();
+        }
+
+        // Checks if any bit is set.
+        bool any() const
+        {
+            return simd::findNonZeroWord(m_words, wordCount()) != wordCount();
+        }
+
+        // Checks if no bit is set.
+        bool none() const
+        {
+            return !any();
+        }
+
+        // Checks if every bit is set (true for an empty bitset).
+        bool all() const
+        {
+            return count() == m_size;
+        }
+
+        // Finds the first set bit.
+        // Returns: The index of the first set bit, or size() if no bit is set.
+        size_t findFirst() const
+        {
+            return findFrom(0);
+        }
+
+        // Finds the first set bit after a position.
+        // Param: index - The position to search after.
+        // Returns: The index of the first set bit greater than index, or size() if there is none.
+        size_t findNext(size_t index) const
+        {
+            if (index >= m_size || index + 1 == m_size)
+                return m_size;
+            return findFrom(index + 1);
+        }
+
+        // Bitwise AND with another bitset of the same size.
+        // Param: other - The other bitset.
+        // Returns: A reference to this bitset.
+        // Throws: "Bitset size mismatch" if the sizes differ.
+        DynamicBitset& operator&=(const DynamicBitset& other)
+        {
+            return combine<simd::WordOp::And>(other);
+        }
+
+        // Bitwise OR with another bitset of the same size.
+        // Param: other - The other bitset.
+        // Returns: A reference to this bitset.
+        // Throws: "Bitset size mismatch" if the sizes differ.
+        DynamicBitset& operator|=(const DynamicBitset& other)
+        {
+            return combine<simd::WordOp::Or>(other);
+        }
+
+        // Bitwise XOR with another bitset of the same size.
+        // Param: other - The other bitset.
+        // Returns: A reference to this bitset.
+        // Throws: "Bitset size mismatch" if the sizes differ.
+        DynamicBitset& operator^=(const DynamicBitset& other)
+        {
+            return combine<simd::WordOp::Xor>(other);
+        }
+
+        // Set difference: clears the bits set in another bitset of the same size.
+        // Param: other - The other bitset.
+        // Returns: A reference to this bitset.
+        // Throws: "Bitset size mismatch" if the sizes differ.
+        DynamicBitset& operator-=(const DynamicBitset& other)
+        {
+            return combine<simd::WordOp::AndNot>(other);
+        }
+
+        // Returns a copy with every bit inverted.
+        DynamicBitset operator~() const
+        {
+            DynamicBitset result(*this);
+            result.flip();
+            return result;
+        }
+
+        // Compares this bitset with another bitset for equality.
+        // Param: other - The bitset to compare with.
+        // Returns: true if both bitsets have the same size and bits, false otherwise.
+        bool operator==(const DynamicBitset& other) const
+        {
+            return m_size == other.m_size && bulk::equal(m_words, other.m_words, wordCount());
+        }
+
+        // Compares this bitset with another bitset for inequality.
+        // Param: other - The bitset to compare with.
+        // Returns: true if the bitsets differ, false otherwise.
+        bool operator!=(const DynamicBitset& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        // Words per worker below which whole-bitset operations stay on the calling thread.
+        static constexpr size_t kParallelWords = bulk::kParallelBytes / sizeof(Word);
+
+        Word* m_words;     // Storage words.
+        size_t m_size;     // Number of bits.
+        size_t m_capacity; // Number of allocated words.
+        std::pmr::memory_resource* m_resource; // Resource owning the storage, or nullptr for the global heap.
+
+        static size_t wordsFor(size_t bits)
+        {
+            return bits / bitsPerWord + (bits % bitsPerWord != 0);
+        }
+
+        // Runs body(begin, end) over the word range, in parallel for large bitsets.
+        template <typename F>
+        void forWords(F body) const
+        {
+            parallel::forRange(wordCount(), kParallelWords, body);
+        }
+
+        // Clears the bits of the last word past the size.
+        void clearTail()
+        {
+            if (m_size % bitsPerWord != 0)
+                m_words[m_size / bitsPerWord] &= ~Word(0) >> (bitsPerWord - m_size % bitsPerWord);
+        }
+
+        // Sets or clears the bits of a word selected by a mask.
+        void applyMask(size_t word, Word mask, bool value)
+        {
+            if (value)
+                m_words[word] |= mask;
+            else
+                m_words[word] &= ~mask;
+        }
+
+        // Moves the words in use into storage of a new number of words.
+        void reallocate(size_t newCapacity)
+        {
+            Word* words = memory::allocateArray<Word>(m_resource, newCapacity);
+            if (m_size != 0)
+                bulk::copy(m_words, words, wordsFor(m_size));
+            memory::deallocateArray(m_resource, m_words, m_capacity);
+            m_words = words;
+            m_capacity = newCapacity;
+        }
+
+        // Finds the first set bit at or after a valid index.
+        size_t findFrom(size_t index) const
+        {
+            if (index >= m_size)
+                return m_size;
+            size_t word = index / bitsPerWord;
+            const Word bits = m_words[word] & (~Word(0) << (index % bitsPerWord));
+            if (bits != 0)
+                return word * bitsPerWord + static_cast<size_t>(std::countr_zero(bits));
+            word += 1 + simd::findNonZeroWord(m_words + word + 1, wordCount() - word - 1);
+            if (word == wordCount())
+                return m_size;
+            return word * bitsPerWord + static_cast<size_t>(std::countr_zero(m_words[word]));
+        }
+
+        template <simd::WordOp Op>
+        DynamicBitset& combine(const DynamicBitset& other)
+        {
+            if (m_size != other.m_size)
+                throw "Bitset size mismatch";
+            const Word* source = other.m_words;
+            forWords([this, source](size_t begin, size_t end)
+            {
+                simd::combineWords<Op>(m_words + begin, source + begin, end - begin);
+            });
+            return *this;
+        }
+    };
+
+    // Bitwise AND of two bitsets of the same size.
+    inline DynamicBitset operator&(const DynamicBitset& lhs, const DynamicBitset& rhs)
+    {
+        DynamicBitset result(lhs);
+        result &= rhs;
+        return result;
+    }
+
+    // Bitwise OR of two bitsets of the same size.
+    inline DynamicBitset operator|(const DynamicBitset& lhs, const DynamicBitset& rhs)
+    {
+        DynamicBitset result(lhs);
+        result |= rhs;
+        return result;
+    }
+
+    // Bitwise XOR of two bitsets of the same size.
+    inline DynamicBitset operator^(const DynamicBitset& lhs, const DynamicBitset& rhs)
+    {
+        DynamicBitset result(lhs);
+        result ^= rhs;
+        return result;
+    }
+
+    // Bits set in lhs but not in rhs (same size).
+    inline DynamicBitset operator-(const DynamicBitset& lhs, const DynamicBitset& rhs)
+    {
+        DynamicBitset result(lhs);
+        result -= rhs;
+        return result;
+    }
+
+    // A DynamicBitset owns its words only through a pointer, so it can be relocated with memcpy.
+    template <>
+    struct memory::IsTriviallyRelocatable<DynamicBitset> : std::true_type {};
+} // namespace mylib
+
+#endif // MYLIB_BITSET_H
@@ -0,0 +1,258 @@
+#ifndef MYLIB_BULK_H
+#define MYLIB_BULK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "MyParallel.h"
+#include "MySimd.h"
+
+namespace mylib
+{
+    /**
+     * Bulk fill, copy and compare over contiguous ranges. Trivially copyable types go
+     * through memset/memcpy/memcmp, large ranges are split across worker threads, and
+     * fills and copies bigger than the last-level cache use non-temporal stores so they
+     * do not evict the working set. Small ranges stay serial.
+     */
+    namespace bulk
+    {
+        /// Bytes per worker below which a bulk operation stays on the calling thread.
+        constexpr size_t kParallelBytes = size_t(1) << 22;
+
+        /// Total size from which fills and copies bypass the cache.
+        constexpr size_t kNonTemporalBytes = size_t(1) << 25;
+
+        namespace detail
+        {
+            /**
+             * Checks whether every byte of a value is the same, so a fill can use memset.
+             */
+            template <typename T>
+            bool uniformBytes(const T& value, unsigned char& byte)
+            {
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+                byte = bytes[0];
+                for (size_t i = 1; i < sizeof(T); ++i)
+                    if (bytes[i] != byte)
+                        return false;
+                return true;
+            }
+
+            /**
+             * Minimum number of elements handed to one worker.
+             */
+            template <typename T>
+            constexpr size_t minChunk()
+            {
+                return kParallelBytes / sizeof(T) + 1;
+            }
+
+#ifdef MYLIB_HAS_SSE2
+            /**
+             * Copies bytes with streaming stores. The destination tail and unaligned head use memcpy.
+             */
+            inline void streamCopy(void* dst, const void* src, size_t bytes)
+            {
+                char* out = static_cast<char*>(dst);
+                const char* in = static_cast<const char*>(src);
+                const size_t head = (16 - (reinterpret_cast<uintptr_t>(out) & 15)) & 15;
+                if (head >= bytes)
+                {
+                    std::memcpy(out, in, bytes);
+                    return;
+                }
+                std::memcpy(out, in, head);
+                out += head;
+                in += head;
+                bytes -= head;
+                size_t i = 0;
+                for (; i + 64 <= bytes; i += 64)
+                {
+                    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16));
+                    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 32));
+                    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 48));
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(out + i), a);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(out + i + 16), b);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(out + i + 32), c);
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(out + i + 48), d);
+                }
+                for (; i + 16 <= bytes; i += 16)
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(out + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+                std::memcpy(out + i, in + i, bytes - i);
+                _mm_sfence();
+            }
+
+            /**
+             * Fills a range with streaming stores when the value repeats every 16 bytes.
+             * @return False if the range cannot be streamed (the caller fills it normally).
+             */
+            template <typename T>
+            bool streamFill(T* data, size_t count, const T& value)
+            {
+                if (16 % sizeof(T) != 0)
+                    return false;
+                size_t i = 0;
+                while (i < count && (reinterpret_cast<uintptr_t>(data + i) & 15) != 0 && i < 16)
+                    std::memcpy(static_cast<void*>(data + i++), &value, sizeof(T));
+                if ((reinterpret_cast<uintptr_t>(data + i) & 15) != 0)
+                    return i == count;
+                alignas(16) unsigned char pattern[16];
+                for (size_t b = 0; b < 16; b += sizeof(T))
+                    std::memcpy(pattern + b, &value, sizeof(T));
+                const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern));
+                const size_t perVector = 16 / sizeof(T);
+                for (; i + perVector <= count; i += perVector)
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(data + i), v);
+                for (; i < count; ++i)
+                    std::memcpy(static_cast<void*>(data + i), &value, sizeof(T));
+                _mm_sfence();
+                return true;
+            }
+#endif
+
+            /**
+             * Serially fills [data, data + count) with value.
+             */
+            template <typename T>
+            void fillRange(T* data, size_t count, const T& value, bool nonTemporal)
+            {
+                if constexpr (std::is_trivially_copyable_v<T>)
+                {
+                    unsigned char byte;
+                    if (uniformBytes(value, byte) && !nonTemporal)
+                    {
+                        std::memset(static_cast<void*>(data), byte, count * sizeof(T));
+                        return;
+                    }
+#ifdef MYLIB_HAS_SSE2
+                    if (nonTemporal && streamFill(data, count, value))
+                        return;
+#endif
+                }
+                for (size_t i = 0; i < count; ++i)
+                    data[i] = value;
+            }
+
+            /**
+             * Serially copies count trivially copyable elements between non-overlapping ranges.
+             */
+            template <typename T>
+            void copyRange(const T* src, T* dst, size_t count, bool nonTemporal)
+            {
+#ifdef MYLIB_HAS_SSE2
+                if (nonTemporal)
+                {
+                    streamCopy(dst, src, count * sizeof(T));
+                    return;
+                }
+#endif
+                (void)nonTemporal;
+                std::memcpy(static_cast<void*>(dst), src, count * sizeof(T));
+            }
+
+            /**
+             * Serially compares two ranges for equality.
+             */
+            template <typename T>
+            bool equalRange(const T* lhs, const T* rhs, size_t count)
+            {
+                if constexpr (simd::kBitwiseComparable<T>)
+                    return std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
+                else
+                    return simd::mismatch(lhs, rhs, count) == count;
+            }
+        }
+
+        /**
+         * Fills a range with a value, in parallel for large trivially copyable ranges.
+         * @param data Pointer to the first element.
+         * @param count The number of elements.
+         * @param value The value to store.
+         */
+        template <typename T>
+        void fill(T* data, size_t count, const T& value)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                const T copy = value;  // value may live inside the range
+                const bool nonTemporal = count * sizeof(T) >= kNonTemporalBytes;
+                parallel::forRange(count, detail::minChunk<T>(), [=](size_t begin, size_t end)
+                {
+                    detail::fillRange(data + begin, end - begin, copy, nonTemporal);
+                });
+            }
+            else
+                detail::fillRange(data, count, value, false);
+        }
+
+        /**
+         * Copies a trivially copyable range into a non-overlapping one, in parallel for large ranges.
+         * @param src Pointer to the first source element.
+         * @param dst Pointer to the first destination element.
+         * @param count The number of elements.
+         */
+        template <typename T>
+        void copy(const T* src, T* dst, size_t count)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "bulk::copy needs trivially copyable elements");
+            if (count == 0)
+                return;
+            const bool nonTemporal = count * sizeof(T) >= kNonTemporalBytes;
+            parallel::forRange(count, detail::minChunk<T>(), [=](size_t begin, size_t end)
+            {
+                detail::copyRange(src + begin, dst + begin, end - begin, nonTemporal);
+            });
+        }
+
+        /**
+         * Compares two ranges of the same length for equality, in parallel for large ranges.
+         * Integral, enum and pointer elements are compared with memcmp, floating-point ones
+         * with SIMD compares (IEEE equality, so a range holding NaN is unequal even to itself),
+         * others with operator==.
+         * @param lhs Pointer to the first range.
+         * @param rhs Pointer to the second range.
+         * @param count The number of elements.
+         * @return True if every pair of elements compares equal.
+         */
+        template <typename T>
+        bool equal(const T* lhs, const T* rhs, size_t count)
+        {
+            if (count == 0)
+                return true;
+            if constexpr (simd::kBitwiseComparable<T>)
+            {
+                // Only where == is reflexive: a NaN, also inside std::complex or a user type,
+                // never equals itself, so such ranges are always compared.
+                if (lhs == rhs)
+                    return true;
+            }
+            if constexpr (!std::is_trivially_copyable_v<T>)
+                return detail::equalRange(lhs, rhs, count);
+            else
+            {
+                if (count < 2 * detail::minChunk<T>())
+                    return detail::equalRange(lhs, rhs, count);
+                std::atomic<bool> same{ true };
+                parallel::forRange(count, detail::minChunk<T>(), [&](size_t begin, size_t end)
+                {
+                    // Compare in slices so a mismatch found elsewhere stops this worker early.
+                    const size_t slice = detail::minChunk<T>() / 4 + 1;
+                    for (size_t i = begin; i < end && same.load(std::memory_order_relaxed); i += slice)
+                    {
+                        const size_t n = end - i < slice ? end - i : slice;
+                        if (!detail::equalRange(lhs + i, rhs + i, n))
+                            same.store(false, std::memory_order_relaxed);
+                    }
+                });
+                return same;
+            }
+        }
+    } // namespace bulk
+} // namespace mylib
+
+#endif // MYLIB_BULK_H
@@ -0,0 +1,405 @@
+#ifndef MYLIB_CONCURRENT_VECTOR_H
+#define MYLIB_CONCURRENT_VECTOR_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "MyConfig.h"
+#include "MyMemory.h"
+
+namespace mylib
+{
+    // Append-only vector that many threads can grow at once. Storage is a fixed table of
+    // segments of geometrically growing size (segment k holds firstSegmentSize << k elements),
+    // so growing never moves an element and references stay valid until clear() or destruction.
+    // Appends reserve their slots with an atomic fetch-add. The first thread to need a missing
+    // segment claims it with a compare-and-swap and allocates it while other threads appending
+    // into it wait, so each segment is allocated exactly once; appends into allocated segments
+    // never wait. Each slot publishes itself after construction through a per-segment bitmap;
+    // readers may access an element concurrently with appends once published() returns true
+    // for it, or once the appending thread has handed its index over.
+    // Heap storage comes from an optional std::pmr::memory_resource, which must be thread-safe.
+    // Param: T - The type of elements stored in the vector.
+    template <typename T>
+    class ConcurrentVector {
+    public:
+        // Number of elements in the first segment; every later segment doubles it.
+        static constexpr size_t firstSegmentSize = 32;
+
+        // Default constructor initializes an empty vector without allocating.
+        // Param: resource - The memory resource for the segments, or nullptr for the global heap.
+        explicit ConcurrentVector(std::pmr::memory_resource* resource = nullptr) : m_size(0), m_resource(resource)
+        {
+            for (std::atomic<unsigned char*>& block : m_blocks)
+                block.store(nullptr, std::memory_order_relaxed);
+        }
+
+        // Constructor with initial capacity.
+        // Param: initialCapacity - The number of elements to allocate segments for.
+        // Param: resource - The memory resource for the segments, or nullptr for the global heap.
+        explicit ConcurrentVector(size_t initialCapacity, std::pmr::memory_resource* resource = nullptr) : ConcurrentVector(resource)
+        {
+            reserve(initialCapacity);
+        }
+
+        // Segments are owned by address, so the vector is neither copyable nor movable.
+        ConcurrentVector(const ConcurrentVector&) = delete;
+        ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+        // Destructor. Must not run concurrently with any other operation.
+        ~ConcurrentVector()
+        {
+            clear();
+        }
+
+        // Constructs an element at the end of the vector. Safe to call from several threads.
+        // Param: args - The arguments forwarded to T's constructor.
+        // Returns: The index of the new element.
+        // Throws: std::bad_alloc if the vector is full or a segment cannot be allocated.
+        // If T's constructor throws, the slot stays reserved but is never published.
+        template <typename... Args>
+        size_t emplace_back(Args&&... args)
+        {
+            const size_t index = reserveSlots(1);
+            construct(index, std::forward<Args>(args)...);
+            return index;
+        }
+
+        // Adds a copy of an element to the end of the vector. Safe to call from several threads.
+        // Param: element - The element to add.
+        // Returns: The index of the new element.
+        size_t push_back(const T& element)
+        {
+            return emplace_back(element);
+        }
+
+        // Moves an element to the end of the vector. Safe to call from several threads.
+        // Param: element - The element to move.
+        // Returns: The index of the new element.
+        size_t push_back(T&& element)
+        {
+            return emplace_back(std::move(element));
+        }
+
+        // Appends count value-initialized elements as one contiguous run of indices.
+        // Safe to call from several threads.
+        // Param: count - The number of elements to append.
+        // Returns: The index of the first new element.
+        // Throws: std::bad_alloc if the vector is full or a segment cannot be allocated.
+        size_t grow_by(size_t count)
+        {
+            const size_t first = reserveSlots(count);
+            for (size_t i = first; i < first + count; ++i)
+                construct(i);
+            return first;
+        }
+
+        // Appends count copies of a value as one contiguous run of indices.
+        // Safe to call from several threads.
+        // Param: count - The number of elements to append.
+        // Param: value - The value to copy.
+        // Returns: The index of the first new element.
+        // Throws: std::bad_alloc if the vector is full or a segment cannot be allocated.
+        size_t grow_by(size_t count, const T& value)
+        {
+            const size_t first = reserveSlots(count);
+            for (size_t i = first; i < first + count; ++i)
+                construct(i, value);
+            return first;
+        }
+
+        // Allocates the segments needed to hold count elements. Safe to call from several threads.
+        // Param: count - The number of elements.
+        // Throws: std::bad_alloc if a segment cannot be allocated.
+        void reserve(size_t count)
+        {
+            if (count == 0)
+                return;
+            if (count > max_size())
+                throw std::bad_alloc();
+            const size_t last = locate(count - 1).segment;
+            for (size_t segment = 0; segment <= last; ++segment)
+                segmentBlock(segment);
+        }
+
+        // Access element at a specific index (checked in debug builds).
+        // The element must be published; it may be read while other threads append.
+        // Param: index - The index of the element to access.
+        // Returns: A reference to the element at the specified index.
+        // Throws: "Index out of range" if the index is invalid (checked builds only).
+        T& operator[](size_t index)
+        {
+            detail::checkIndex(index, size());
+            return *slot(index);
+        }
+
+        // Access element at a specific index (checked in debug builds).
+        // Param: index - The index of the element to access.
+        // Returns: A const reference to the element at the specified index.
+        // Throws: "Index out of range" if the index is invalid (checked builds only).
+        const T& operator[](size_t index) const
+        {
+            detail::checkIndex(index, size());
+            return *slot(index);
+        }
+
+        // Access element at a specific index (always checked).
+        // Param: index - The index of the element to access.
+        // Returns: A reference to the element at the specified index.
+        // Throws: "Index out of range" if the index is invalid.
+        // Throws: "Element not published" if the element is still being constructed.
+        T& at(size_t index)
+        {
+            detail::checkIndexAlways(index, size());
+            if (!published(index))
+                throw "Element not published";
+            return *slot(index);
+        }
+
+        // Access element at a specific index (always checked).
+        // Param: index - The index of the element to access.
+        // Returns: A const reference to the element at the specified index.
+        // Throws: "Index out of range" if the index is invalid.
+        // Throws: "Element not published" if the element is still being constructed.
+        const T& at(size_t index) const
+        {
+            detail::checkIndexAlways(index, size());
+            if (!published(index))
+                throw "Element not published";
+            return *slot(index);
+        }
+
+        // Checks whether an element has been fully constructed and may be read.
+        // Param: index - The index of the element.
+        // Returns: True if the element at index is published.
+        bool published(size_t index) const
+        {
+            if (index >= size())
+                return false;
+            const Location location = locate(index);
+            unsigned char* block = m_blocks[location.segment].load(std::memory_order_acquire);
+            if (block == nullptr || block == pendingBlock())
+                return false;
+            const std::atomic<uint64_t>* words = readyWords(block);
+            return (words[location.offset / 64].load(std::memory_order_acquire) >> (location.offset % 64)) & 1;
+        }
+
+        // Get the number of reserved slots. Slots reserved by appends still in progress
+        // are counted before they are published.
+        // Returns: The size of the vector.
+        size_t size() const
+        {
+            return m_size.load(std::memory_order_acquire);
+        }
+
+        // Checks whether no slot has been reserved.
+        // Returns: True if the vector is empty.
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        // Get the number of elements the allocated segments can hold without further allocation.
+        // Returns: The capacity of the vector.
+        size_t capacity() const
+        {
+            size_t total = 0;
+            for (size_t segment = 0; segment < kSegmentCount; ++segment)
+            {
+                unsigned char* block = m_blocks[segment].load(std::memory_order_acquire);
+                if (block == nullptr || block == pendingBlock())
+                    break;
+                total += segmentSize(segment);
+            }
+            return total;
+        }
+
+        // Get the largest number of elements the vector can hold.
+        // Returns: The maximum size.
+        size_t max_size() const
+        {
+            return (std::numeric_limits<size_t>::max() - firstSegmentSize) / sizeof(T);
+        }
+
+        // Get the memory resource used for the segments.
+        // Returns: The memory resource, or nullptr for the global heap.
+        std::pmr::memory_resource* resource() const
+        {
+            return m_resource;
+        }
+
+        // Destroys every published element and frees the segments.
+        // Must not run concurrently with any other operation.
+        void clear()
+        {
+            for (size_t segment = 0; segment < kSegmentCount; ++segment)
+            {
+                unsigned char* block = m_blocks[segment].load(std::memory_order_acquire);
+                if (block == nullptr)
+                    continue;
+                const std::atomic<uint64_t>* words = readyWords(block);
+                T* elements = segmentElements(block, segment);
+                for (size_t word = 0; word < wordCount(segment); ++word)
+                {
+                    for (uint64_t bits = words[word].load(std::memory_order_relaxed); bits != 0; bits &= bits - 1)
+                        elements[word * 64 + std::countr_zero(bits)].~T();
+                }
+                memory::deallocate(m_resource, block, blockBytes(segment), kBlockAlignment);
+                m_blocks[segment].store(nullptr, std::memory_order_relaxed);
+            }
+            m_size.store(0, std::memory_order_release);
+        }
+
+    private:
+        static constexpr unsigned kFirstSegmentBits = std::countr_zero(firstSegmentSize);
+        static constexpr size_t kSegmentCount = std::numeric_limits<size_t>::digits - kFirstSegmentBits;
+        static constexpr size_t kBlockAlignment = alignof(T) > alignof(std::atomic<uint64_t>) ? alignof(T) : alignof(std::atomic<uint64_t>);
+
+        static_assert(std::has_single_bit(firstSegmentSize), "The first segment size must be a power of two");
+
+        // Segment and offset of an element.
+        struct Location
+        {
+            size_t segment;
+            size_t offset;
+        };
+
+        std::atomic<size_t> m_size;                         // Number of reserved slots
+        std::atomic<unsigned char*> m_blocks[kSegmentCount]; // Per segment: ready bitmap followed by the elements
+        std::pmr::memory_resource* m_resource;              // Source of the segments, or nullptr for the global heap
+
+        // Placeholder block pointer of a segment that one thread is allocating.
+        static unsigned char* pendingBlock()
+        {
+            static unsigned char marker;
+            return &marker;
+        }
+
+        // Maps an index to its segment and offset: index + firstSegmentSize has its top bit
+        // at kFirstSegmentBits + segment.
+        static Location locate(size_t index)
+        {
+            const size_t shifted = index + firstSegmentSize;
+            const size_t top = std::bit_width(shifted) - 1;
+            return { top - kFirstSegmentBits, shifted - (size_t(1) << top) };
+        }
+
+        static size_t segmentSize(size_t segment)
+        {
+            return firstSegmentSize << segment;
+        }
+
+        static size_t wordCount(size_t segment)
+        {
+            return (segmentSize(segment) + 63) / 64;
+        }
+
+        // Byte offset of the elements inside a block, past the ready bitmap.
+        static size_t elementOffset(size_t segment)
+        {
+            const size_t bitmap = wordCount(segment) * sizeof(std::atomic<uint64_t>);
+            return (bitmap + alignof(T) - 1) / alignof(T) * alignof(T);
+        }
+
+        // Total bytes of a segment's block.
+        // Throws: std::bad_alloc if the block size overflows.
+        static size_t blockBytes(size_t segment)
+        {
+            const size_t count = segmentSize(segment);
+            if (count > (std::numeric_limits<size_t>::max() - elementOffset(segment)) / sizeof(T))
+                throw std::bad_alloc();
+            return elementOffset(segment) + count * sizeof(T);
+        }
+
+        static std::atomic<uint64_t>* readyWords(unsigned char* block)
+        {
+            return reinterpret_cast<std::atomic<uint64_t>*>(block);
+        }
+
+        static T* segmentElements(unsigned char* block, size_t segment)
+        {
+            return reinterpret_cast<T*>(block + elementOffset(segment));
+        }
+
+        // Reserves count consecutive slots. The size only grows once the run is known to fit,
+        // so a failed reservation leaves no unpublished slots below size().
+        // Returns: The index of the first slot.
+        // Throws: std::bad_alloc if the vector is full.
+        size_t reserveSlots(size_t count)
+        {
+            if (count > max_size())
+                throw std::bad_alloc();
+            size_t first = m_size.load(std::memory_order_relaxed);
+            do
+            {
+                if (first > max_size() - count)
+                    throw std::bad_alloc();
+            } while (!m_size.compare_exchange_weak(first, first + count, std::memory_order_relaxed));
+            return first;
+        }
+
+        // Returns a segment's block, allocating it if no thread has done so yet. The first thread
+        // to find the segment missing swaps in the pending marker and allocates; threads arriving
+        // meanwhile wait for the real pointer, so racing appends never allocate a block each.
+        // Throws: std::bad_alloc if the block cannot be allocated (the claim is dropped, so a
+        // waiting thread retries the allocation).
+        unsigned char* segmentBlock(size_t segment)
+        {
+            for (;;)
+            {
+                unsigned char* block = m_blocks[segment].load(std::memory_order_acquire);
+                if (block != nullptr && block != pendingBlock())
+                    return block;
+                if (block == nullptr && m_blocks[segment].compare_exchange_strong(block, pendingBlock(), std::memory_order_relaxed))
+                    return allocateSegment(segment);
+                std::this_thread::yield();
+            }
+        }
+
+        // Allocates and installs the block of a segment this thread has claimed.
+        // Throws: std::bad_alloc if the block cannot be allocated.
+        unsigned char* allocateSegment(size_t segment)
+        {
+            unsigned char* fresh;
+            try
+            {
+                fresh = static_cast<unsigned char*>(memory::allocate(m_resource, blockBytes(segment), kBlockAlignment));
+            }
+            catch (...)
+            {
+                m_blocks[segment].store(nullptr, std::memory_order_release);
+                throw;
+            }
+            std::atomic<uint64_t>* words = readyWords(fresh);
+            for (size_t word = 0; word < wordCount(segment); ++word)
+                ::new (static_cast<void*>(words + word)) std::atomic<uint64_t>(0);
+            m_blocks[segment].store(fresh, std::memory_order_release);
+            return fresh;
+        }
+
+        // Constructs the element of a reserved slot and publishes it.
+        template <typename... Args>
+        void construct(size_t index, Args&&... args)
+        {
+            const Location location = locate(index);
+            unsigned char* block = segmentBlock(location.segment);
+            ::new (static_cast<void*>(segmentElements(block, location.segment) + location.offset)) T(std::forward<Args>(args)...);
+            readyWords(block)[location.offset / 64].fetch_or(uint64_t(1) << (location.offset % 64), std::memory_order_release);
+        }
+
+        T* slot(size_t index) const
+        {
+            const Location location = locate(index);
+            return segmentElements(m_blocks[location.segment].load(std::memory_order_acquire), location.segment) + location.offset;
+        }
+    };
+} // namespace mylib
+
+#endif // MYLIB_CONCURRENT_VECTOR_H
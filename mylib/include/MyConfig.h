@@ -0,0 +1,83 @@
+#ifndef MYLIB_CONFIG_H
+#define MYLIB_CONFIG_H
+
+#include <cstddef>
+#include <iostream>
+
+/*
+    Bounds-check policy shared by every mylib container.
+
+    MYLIB_BOUNDS_CHECK selects whether operator[] and operator() check their
+    indices. It defaults to 1 in debug builds and 0 when NDEBUG is defined,
+    and can be forced either way on the command line. at() is always checked.
+*/
+#ifndef MYLIB_BOUNDS_CHECK
+#ifdef NDEBUG
+#define MYLIB_BOUNDS_CHECK 0
+#else
+#define MYLIB_BOUNDS_CHECK 1
+#endif
+#endif
+
+namespace mylib
+{
+    /// True if unchecked accessors validate their indices in this build.
+    constexpr bool kBoundsCheck = MYLIB_BOUNDS_CHECK != 0;
+
+    /**
+     * Tag type selecting constructors and resizes that leave elements default-initialized
+     * (indeterminate for trivial types) instead of zeroing them. Use it when every element
+     * is about to be overwritten anyway.
+     */
+    struct Uninitialized
+    {
+        explicit Uninitialized() = default;
+    };
+
+    /// Tag value passed to the uninitialized constructors and resizes.
+    inline constexpr Uninitialized uninitialized{};
+
+    namespace detail
+    {
+        /**
+         * Reports an out-of-range access and throws.
+         * In checked builds the offending index and the container size are written to std::cerr.
+         * @param index The index that was requested.
+         * @param size The size of the container.
+         * @throws "Index out of range" always.
+         */
+        [[noreturn]] inline void indexOutOfRange(size_t index, size_t size)
+        {
+            if (kBoundsCheck)
+                std::cerr << "mylib: index " << index << " out of range for size " << size << "\n";
+            throw "Index out of range";
+        }
+
+        /**
+         * Validates an index regardless of the build mode (used by at()).
+         * @param index The index to check.
+         * @param size The size of the container.
+         * @throws "Index out of range" if index >= size.
+         */
+        inline void checkIndexAlways(size_t index, size_t size)
+        {
+            if (index >= size)
+                indexOutOfRange(index, size);
+        }
+
+        /**
+         * Validates an index in checked builds and compiles to nothing otherwise
+         * (used by operator[] and operator()).
+         * @param index The index to check.
+         * @param size The size of the container.
+         * @throws "Index out of range" if checking is enabled and index >= size.
+         */
+        inline void checkIndex(size_t index, size_t size)
+        {
+            if constexpr (kBoundsCheck)
+                checkIndexAlways(index, size);
+        }
+    } // namespace detail
+} // namespace mylib
+
+#endif // MYLIB_CONFIG_H
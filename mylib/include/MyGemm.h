@@ -0,0 +1,367 @@
+#ifndef MYLIB_GEMM_H
+#define MYLIB_GEMM_H
+
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+#include "MyArray.h"
+
+namespace mylib
+{
+    /**
+     * Cache blocking parameters of the matrix-multiply kernel.
+     */
+    struct GemmBlocking
+    {
+        size_t rowBlock;    ///< Rows of A (and C) processed per block.
+        size_t depthBlock;  ///< Shared dimension processed per block (rows of the B panel).
+        size_t colBlock;    ///< Columns of B (and C) processed per block.
+    };
+
+    /**
+     * Blocked matrix multiply with per-element-type block sizes. Block sizes come
+     * from a per-machine profile file when one exists, are measured on first use
+     * when autotuning is enabled, and fall back to fixed defaults otherwise.
+     *
+     * The profile path is taken from the MYLIB_GEMM_PROFILE environment variable,
+     * or defaults to ".mylib_gemm_profile" in the user's home directory. Setting
+     * MYLIB_GEMM_AUTOTUNE=1 enables tuning on first use.
+     */
+    namespace gemm
+    {
+        /// Candidate values tried for each blocking parameter.
+        constexpr size_t kCandidates[] = { 16, 32, 64, 128, 256, 512 };
+
+        /// Matrix size used when benchmarking candidates.
+        constexpr size_t kDefaultBenchmarkSize = 256;
+
+        namespace detail
+        {
+            struct State
+            {
+                std::mutex lock;
+                bool loaded = false;
+                bool autotune = false;
+                std::string path;
+                std::map<std::string, GemmBlocking> profile;
+            };
+
+            inline State& state()
+            {
+                static State instance;
+                return instance;
+            }
+
+            inline std::string defaultProfilePath()
+            {
+                if (const char* path = std::getenv("MYLIB_GEMM_PROFILE"))
+                    return path;
+                const char* home = std::getenv("HOME");
+                if (!home)
+                    home = std::getenv("USERPROFILE");
+                return home ? std::string(home) + "/.mylib_gemm_profile" : std::string(".mylib_gemm_profile");
+            }
+
+            /**
+             * Reads a profile file into a map, keeping entries already in it for types
+             * the file lacks. Lines have the form "<type> <rowBlock> <depthBlock> <colBlock>";
+             * malformed lines are skipped.
+             */
+            inline void readProfile(const std::string& path, std::map<std::string, GemmBlocking>& profile)
+            {
+                std::ifstream in(path);
+                std::string line;
+                while (std::getline(in, line))
+                {
+                    std::istringstream fields(line);
+                    std::string key;
+                    GemmBlocking blocking{};
+                    if (fields >> key >> blocking.rowBlock >> blocking.depthBlock >> blocking.colBlock
+                        && blocking.rowBlock && blocking.depthBlock && blocking.colBlock)
+                        profile[key] = blocking;
+                }
+            }
+
+            /**
+             * Reads the profile file into the state.
+             * Must be called with the state lock held.
+             */
+            inline void loadLocked(State& s)
+            {
+                if (s.loaded)
+                    return;
+                s.loaded = true;
+                if (s.path.empty())
+                    s.path = defaultProfilePath();
+                if (const char* flag = std::getenv("MYLIB_GEMM_AUTOTUNE"))
+                    s.autotune = flag[0] == '1';
+                readProfile(s.path, s.profile);
+            }
+
+            /**
+             * Stores the entry for one type and saves the profile. The file is re-read first,
+             * so entries other processes tuned meanwhile are kept, and the result is written
+             * to a temporary file renamed over the profile, so readers never see a partial file.
+             * Must be called with the state lock held.
+             * @param s The state; its profile is updated with the merged entries.
+             * @param key The type key.
+             * @param blocking The blocking for that type.
+             * @return True if the file was written.
+             */
+            inline bool saveLocked(State& s, const std::string& key, const GemmBlocking& blocking)
+            {
+                std::map<std::string, GemmBlocking> merged;
+                readProfile(s.path, merged);
+                for (const auto& entry : s.profile)
+                    merged.emplace(entry.first, entry.second);
+                merged[key] = blocking;
+                s.profile = merged;
+
+                const std::string temporary = s.path + ".tmp";
+                {
+                    std::ofstream out(temporary, std::ios::trunc);
+                    if (!out)
+                        return false;
+                    out << "# mylib GEMM blocking profile: <type> <rowBlock> <depthBlock> <colBlock>\n";
+                    for (const auto& entry : merged)
+                        out << entry.first << " " << entry.second.rowBlock << " "
+                            << entry.second.depthBlock << " " << entry.second.colBlock << "\n";
+                    if (!out.flush())
+                        return false;
+                }
+                std::error_code error;
+                std::filesystem::rename(temporary, s.path, error);
+                if (error)
+                {
+                    std::filesystem::remove(temporary, error);
+                    return false;
+                }
+                return true;
+            }
+
+            /**
+             * Gets the profile key of an element type. Types without a fixed name use
+             * typeid(T).name() with whitespace replaced by '_' (MSVC returns names such as
+             * "class std::complex<double>"), since keys are read back as single words.
+             */
+            template <typename T>
+            std::string typeKey()
+            {
+                if constexpr (std::is_same_v<T, float>) return "float";
+                else if constexpr (std::is_same_v<T, double>) return "double";
+                else if constexpr (std::is_same_v<T, long double>) return "long_double";
+                else if constexpr (std::is_same_v<T, int>) return "int";
+                else if constexpr (std::is_same_v<T, long>) return "long";
+                else if constexpr (std::is_same_v<T, long long>) return "long_long";
+                else if constexpr (std::is_same_v<T, unsigned int>) return "unsigned_int";
+                else
+                {
+                    std::string key = typeid(T).name();
+                    for (char& c : key)
+                    {
+                        if (std::isspace(static_cast<unsigned char>(c)))
+                            c = '_';
+                    }
+                    return key;
+                }
+            }
+
+            template <typename T>
+            constexpr GemmBlocking defaultBlocking()
+            {
+                return GemmBlocking{ 64, 128, 256 };
+            }
+
+            /**
+             * Multiplies one (rowBlock x depthBlock) panel of A by a (depthBlock x colBlock) panel of B into C.
+             * The innermost loop walks a row of B and a row of C contiguously.
+             */
+            template <typename T>
+            void multiplyBlock(const T* a, const T* b, T* c, size_t n,
+                size_t iBegin, size_t iEnd, size_t kBegin, size_t kEnd, size_t jBegin, size_t jEnd)
+            {
+                for (size_t i = iBegin; i < iEnd; ++i)
+                {
+                    T* cRow = c + i * n;
+                    const T* aRow = a + i * n;
+                    for (size_t k = kBegin; k < kEnd; ++k)
+                    {
+                        const T scale = aRow[k];
+                        const T* bRow = b + k * n;
+                        for (size_t j = jBegin; j < jEnd; ++j)
+                            cRow[j] += scale * bRow[j];
+                    }
+                }
+            }
+        }
+
+        /**
+         * Computes c = a * b for n x n row-major buffers with the given blocking.
+         * @param a The left operand.
+         * @param b The right operand.
+         * @param c The output buffer (must not alias a or b).
+         * @param n The matrix dimension.
+         * @param blocking The block sizes to use.
+         */
+        template <typename T>
+        void multiply(const T* a, const T* b, T* c, size_t n, const GemmBlocking& blocking)
+        {
+            for (size_t i = 0; i < n * n; ++i)
+                c[i] = T(0);
+            for (size_t kk = 0; kk < n; kk += blocking.depthBlock)
+            {
+                const size_t kEnd = kk + blocking.depthBlock < n ? kk + blocking.depthBlock : n;
+                for (size_t ii = 0; ii < n; ii += blocking.rowBlock)
+                {
+                    const size_t iEnd = ii + blocking.rowBlock < n ? ii + blocking.rowBlock : n;
+                    for (size_t jj = 0; jj < n; jj += blocking.colBlock)
+                    {
+                        const size_t jEnd = jj + blocking.colBlock < n ? jj + blocking.colBlock : n;
+                        detail::multiplyBlock(a, b, c, n, ii, iEnd, kk, kEnd, jj, jEnd);
+                    }
+                }
+            }
+        }
+
+        /**
+         * Sets the profile file used by later loads and by tune(). Reloads the profile from it.
+         * @param path The profile file path.
+         */
+        inline void setProfilePath(const std::string& path)
+        {
+            detail::State& s = detail::state();
+            std::lock_guard<std::mutex> guard(s.lock);
+            bool autotune = s.autotune;
+            s.profile.clear();
+            s.loaded = false;
+            s.path = path;
+            detail::loadLocked(s);
+            s.autotune = s.autotune || autotune;
+        }
+
+        /**
+         * Gets the profile file path.
+         * @return The path of the profile file.
+         */
+        inline std::string profilePath()
+        {
+            detail::State& s = detail::state();
+            std::lock_guard<std::mutex> guard(s.lock);
+            detail::loadLocked(s);
+            return s.path;
+        }
+
+        /**
+         * Enables or disables tuning on first use for element types missing from the profile.
+         * @param enabled True to benchmark and persist block sizes on first use.
+         */
+        inline void setAutotune(bool enabled)
+        {
+            detail::State& s = detail::state();
+            std::lock_guard<std::mutex> guard(s.lock);
+            detail::loadLocked(s);
+            s.autotune = enabled;
+        }
+
+        /**
+         * Benchmarks candidate block sizes for T, stores the fastest in the profile and saves it.
+         * Each parameter is tuned in turn while the others are held fixed.
+         * @param benchmarkSize The dimension of the square matrices used for timing.
+         * @return The selected blocking.
+         */
+        template <typename T>
+        GemmBlocking tune(size_t benchmarkSize = kDefaultBenchmarkSize)
+        {
+            const size_t n = benchmarkSize == 0 ? 1 : benchmarkSize;
+            Array<T> a(n * n), b(n * n), c(n * n);
+            for (size_t i = 0; i < n * n; ++i)
+            {
+                a.dataPointer()[i] = static_cast<T>(i % 7 + 1);
+                b.dataPointer()[i] = static_cast<T>(i % 5 + 1);
+            }
+
+            auto measure = [&](const GemmBlocking& blocking)
+            {
+                auto best = std::chrono::steady_clock::duration::max();
+                for (int run = 0; run < 3; ++run)
+                {
+                    auto start = std::chrono::steady_clock::now();
+                    multiply(a.dataPointer(), b.dataPointer(), c.dataPointer(), n, blocking);
+                    auto elapsed = std::chrono::steady_clock::now() - start;
+                    best = elapsed < best ? elapsed : best;
+                }
+                return best;
+            };
+
+            GemmBlocking best = detail::defaultBlocking<T>();
+            auto bestTime = measure(best);
+            size_t GemmBlocking::* parameters[] = { &GemmBlocking::depthBlock, &GemmBlocking::colBlock, &GemmBlocking::rowBlock };
+            for (size_t GemmBlocking::* parameter : parameters)
+            {
+                for (size_t candidate : kCandidates)
+                {
+                    if (candidate == best.*parameter)
+                        continue;
+                    GemmBlocking trial = best;
+                    trial.*parameter = candidate;
+                    auto time = measure(trial);
+                    if (time < bestTime)
+                    {
+                        bestTime = time;
+                        best = trial;
+                    }
+                }
+            }
+
+            detail::State& s = detail::state();
+            std::lock_guard<std::mutex> guard(s.lock);
+            detail::loadLocked(s);
+            detail::saveLocked(s, detail::typeKey<T>(), best);
+            return best;
+        }
+
+        /**
+         * Gets the block sizes used for T, loading the profile on first call and
+         * tuning first if autotuning is enabled and T has no profile entry.
+         * @return The blocking for T.
+         */
+        template <typename T>
+        GemmBlocking blocking()
+        {
+            bool needsTuning;
+            {
+                detail::State& s = detail::state();
+                std::lock_guard<std::mutex> guard(s.lock);
+                detail::loadLocked(s);
+                auto entry = s.profile.find(detail::typeKey<T>());
+                if (entry != s.profile.end())
+                    return entry->second;
+                needsTuning = s.autotune;
+            }
+            return needsTuning ? tune<T>() : detail::defaultBlocking<T>();
+        }
+    } // namespace gemm
+
+    /**
+     * Tunes the matrix-multiply block sizes for the common element types
+     * (float, double, int) and writes them to the profile file.
+     */
+    inline void tune()
+    {
+        gemm::tune<float>();
+        gemm::tune<double>();
+        gemm::tune<int>();
+    }
+} // namespace mylib
+
+#endif // MYLIB_GEMM_H
@@ -2,6 +2,10 @@
 #define MYLIB_INTRUSIVE_LIST_H
 
 #include <iostream>
+#include <memory_resource>
+#include <stdexcept>
+
+#include "MyMemory.h"
 
 namespace mylib {
     /**
@@ -32,6 +36,7 @@ namespace mylib {
     /**
      * IntrusiveList class represents a doubly linked list where each node
      * contains the data and links to the next and previous nodes.
+     * Nodes come from an optional std::pmr::memory_resource (the global heap by default).
      * @tparam T Type of the elements in the list.
      */
     template <typename T>
@@ -40,13 +45,125 @@ namespace mylib {
         Node<T>* m_head;  ///< Pointer to the first node in the list.
         Node<T>* m_tail;  ///< Pointer to the last node in the list.
         size_t m_size;    ///< Size of the list.
+        std::pmr::memory_resource* m_resource;  ///< Resource the nodes come from, or nullptr for the global heap.
 
     public:
         /**
          * Constructor to initialize an empty list.
          * The head and tail pointers are set to nullptr, and size is set to 0.
          */
-        IntrusiveList() : m_head(nullptr), m_tail(nullptr), m_size(0) {}
+        IntrusiveList() : m_head(nullptr), m_tail(nullptr), m_size(0), m_resource(nullptr) {}
+
+        /**
+         * Constructor to initialize an empty list whose nodes come from the given memory resource.
+         * @param resource The memory resource, or nullptr for the global heap.
+         */
+        explicit IntrusiveList(std::pmr::memory_resource* resource) : m_head(nullptr), m_tail(nullptr), m_size(0), m_resource(resource) {}
+
+        /**
+         * Copy constructor, copies every element in order.
+         * @param other The list to copy.
+         * @param resource The memory resource for the copy, or nullptr for the global heap.
+         */
+        IntrusiveList(const IntrusiveList& other, std::pmr::memory_resource* resource = nullptr)
+            : m_head(nullptr), m_tail(nullptr), m_size(0), m_resource(resource)
+        {
+            for (Node<T>* current = other.m_head; current; current = current->m_next)
+                push_back(current->m_data);
+        }
+
+        /**
+         * Move constructor, takes over the nodes (and memory resource) of another list.
+         * @param other The list to move from (left empty).
+         */
+        IntrusiveList(IntrusiveList&& other) noexcept
+            : m_head(other.m_head), m_tail(other.m_tail), m_size(other.m_size), m_resource(other.m_resource)
+        {
+            other.m_head = other.m_tail = nullptr;
+            other.m_size = 0;
+        }
+
+        /**
+         * Copy assignment, the copy's nodes come from this list's memory resource.
+         * @param other The list to copy.
+         * @return A reference to this list.
+         */
+        IntrusiveList& operator=(const IntrusiveList& other)
+        {
+            if (this != &other)
+            {
+                IntrusiveList copy(other, m_resource);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        /**
+         * Move assignment, takes over the nodes (and memory resource) of another list.
+         * @param other The list to move from (left empty).
+         * @return A reference to this list.
+         */
+        IntrusiveList& operator=(IntrusiveList&& other) noexcept
+        {
+            if (this != &other)
+            {
+                IntrusiveList moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+
+        /**
+         * Destructor, frees every node.
+         */
+        ~IntrusiveList()
+        {
+            clear();
+        }
+
+        /**
+         * Removes every element from the list.
+         */
+        void clear()
+        {
+            while (m_head)
+            {
+                Node<T>* next = m_head->m_next;
+                memory::destroy(m_resource, m_head);
+                m_head = next;
+            }
+            m_tail = nullptr;
+            m_size = 0;
+        }
+
+        /**
+         * Swaps the contents of two lists; each list's memory resource travels with its nodes.
+         * @param other The list to swap with.
+         */
+        void swap(IntrusiveList& other) noexcept
+        {
+            Node<T>* head = m_head;
+            Node<T>* tail = m_tail;
+            size_t size = m_size;
+            std::pmr::memory_resource* resource = m_resource;
+            m_head = other.m_head;
+            m_tail = other.m_tail;
+            m_size = other.m_size;
+            m_resource = other.m_resource;
+            other.m_head = head;
+            other.m_tail = tail;
+            other.m_size = size;
+            other.m_resource = resource;
+        }
+
+        /**
+         * Gets the memory resource the nodes come from.
+         * @return The resource, or nullptr for the global heap.
+         */
+        std::pmr::memory_resource* resource() const
+        {
+            return m_resource;
+        }
 
         /**
          * Adds an element to the end of the list.
@@ -54,7 +171,7 @@ namespace mylib {
          */
         void push_back(const T& value)
     	{
-            Node<T>* newNode = new Node<T>(value);
+            Node<T>* newNode = memory::create<Node<T>>(m_resource, value);
             if (!m_head)
                 m_head = m_tail = newNode;
             else 
@@ -72,7 +189,7 @@ namespace mylib {
          */
         void push_front(const T& value)
     	{
-            Node<T>* newNode = new Node<T>(value);
+            Node<T>* newNode = memory::create<Node<T>>(m_resource, value);
             if (!m_head)
                 m_head = m_tail = newNode;
             else 
@@ -98,7 +215,7 @@ namespace mylib {
                 m_head->m_prev = nullptr;
             else
                 m_tail = nullptr;
-            delete temp;
+            memory::destroy(m_resource, temp);
             --m_size;
         }
 
@@ -116,7 +233,7 @@ namespace mylib {
                 m_tail->m_next = nullptr;
             else
                 m_head = nullptr;
-            delete temp;
+            memory::destroy(m_resource, temp);
             --m_size;
         }
 
@@ -153,7 +270,7 @@ namespace mylib {
                     nodeToRemove->m_next->m_prev = nodeToRemove->m_prev;
                 else
                     m_tail = nodeToRemove->m_prev;
-                delete nodeToRemove;
+                memory::destroy(m_resource, nodeToRemove);
                 --m_size;
             }
         }
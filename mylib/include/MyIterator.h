@@ -0,0 +1,187 @@
+#ifndef MYLIB_ITERATOR_H
+#define MYLIB_ITERATOR_H
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace mylib
+{
+    /**
+     * Iterator over contiguous storage. It models std::contiguous_iterator, so the
+     * standard algorithms (including the parallel and ranges ones) see it as a pointer.
+     * U is const-qualified for the const iterator; a mutable iterator converts to it.
+     */
+    template <typename U>
+    class ContiguousIterator
+    {
+    public:
+        using iterator_concept = std::contiguous_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<U>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = U*;
+        using reference = U&;
+
+        ContiguousIterator() : m_ptr(nullptr) {}
+
+        /**
+         * Creates an iterator at an element.
+         * @param ptr Pointer to the element.
+         */
+        ContiguousIterator(U* ptr) : m_ptr(ptr) {}
+
+        /**
+         * Converts a mutable iterator to a const one.
+         */
+        template <typename V>
+            requires (std::is_same_v<const V, U> && !std::is_same_v<V, U>)
+        ContiguousIterator(const ContiguousIterator<V>& other) : m_ptr(other.operator->()) {}
+
+        U& operator*() const
+        {
+            return *m_ptr;
+        }
+
+        U* operator->() const
+        {
+            return m_ptr;
+        }
+
+        U& operator[](difference_type offset) const
+        {
+            return m_ptr[offset];
+        }
+
+        ContiguousIterator& operator++()
+        {
+            ++m_ptr;
+            return *this;
+        }
+
+        ContiguousIterator operator++(int)
+        {
+            ContiguousIterator temp = *this;
+            ++m_ptr;
+            return temp;
+        }
+
+        ContiguousIterator& operator--()
+        {
+            --m_ptr;
+            return *this;
+        }
+
+        ContiguousIterator operator--(int)
+        {
+            ContiguousIterator temp = *this;
+            --m_ptr;
+            return temp;
+        }
+
+        ContiguousIterator& operator+=(difference_type offset)
+        {
+            m_ptr += offset;
+            return *this;
+        }
+
+        ContiguousIterator& operator-=(difference_type offset)
+        {
+            m_ptr -= offset;
+            return *this;
+        }
+
+        friend ContiguousIterator operator+(ContiguousIterator it, difference_type offset)
+        {
+            return it += offset;
+        }
+
+        friend ContiguousIterator operator+(difference_type offset, ContiguousIterator it)
+        {
+            return it += offset;
+        }
+
+        friend ContiguousIterator operator-(ContiguousIterator it, difference_type offset)
+        {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const ContiguousIterator& lhs, const ContiguousIterator& rhs)
+        {
+            return lhs.m_ptr - rhs.m_ptr;
+        }
+
+        friend bool operator==(const ContiguousIterator& lhs, const ContiguousIterator& rhs)
+        {
+            return lhs.m_ptr == rhs.m_ptr;
+        }
+
+        friend std::strong_ordering operator<=>(const ContiguousIterator& lhs, const ContiguousIterator& rhs)
+        {
+            return lhs.m_ptr <=> rhs.m_ptr;
+        }
+
+    private:
+        U* m_ptr;  ///< The current element.
+    };
+
+    /**
+     * Reverse iterator over contiguous storage that advances with operator--, like the
+     * reverse iterators of List (use std::reverse_iterator over the contiguous iterators
+     * for the standard algorithms). It holds the position one past its element, so rend()
+     * is the first element's address and no pointer before the storage is ever formed.
+     */
+    template <typename U>
+    class ContiguousReverseIterator
+    {
+    public:
+        using value_type = std::remove_cv_t<U>;
+        using pointer = U*;
+        using reference = U&;
+
+        ContiguousReverseIterator() : m_base(nullptr) {}
+
+        /**
+         * Creates an iterator at the element before a position.
+         * @param base Pointer one past the element.
+         */
+        explicit ContiguousReverseIterator(U* base) : m_base(base) {}
+
+        U& operator*() const
+        {
+            return *(m_base - 1);
+        }
+
+        U* operator->() const
+        {
+            return m_base - 1;
+        }
+
+        /**
+         * Moves to the previous element of the storage (the next one in reverse order).
+         */
+        ContiguousReverseIterator& operator--()
+        {
+            --m_base;
+            return *this;
+        }
+
+        ContiguousReverseIterator operator--(int)
+        {
+            ContiguousReverseIterator temp = *this;
+            --m_base;
+            return temp;
+        }
+
+        friend bool operator==(const ContiguousReverseIterator& lhs, const ContiguousReverseIterator& rhs)
+        {
+            return lhs.m_base == rhs.m_base;
+        }
+
+    private:
+        U* m_base;  ///< One past the current element.
+    };
+} // namespace mylib
+
+#endif // MYLIB_ITERATOR_H
@@ -1,10 +1,17 @@
 #ifndef MYLIB_LIST_H
 #define MYLIB_LIST_H
 
+#include <cstddef>
+#include <iostream>
+#include <memory_resource>
+
+#include "MyMemory.h"
+
 namespace mylib
 {
     /**
      * A doubly linked list implementation.
+     * Nodes come from an optional std::pmr::memory_resource (the global heap by default).
      * @tparam T Type of elements stored in the list.
      */
     template <typename T>
@@ -30,12 +37,72 @@ namespace mylib
         Node* m_head;  // Pointer to the first node in the list
         Node* m_tail;  // Pointer to the last node in the list
         size_t m_size; // Current size of the list
+        std::pmr::memory_resource* m_resource; // Resource the nodes come from, or nullptr for the global heap
 
     public:
         /**
          * Default constructor, initializes an empty list.
          */
-        List() : m_head(nullptr), m_tail(nullptr), m_size(0) {}
+        List() : m_head(nullptr), m_tail(nullptr), m_size(0), m_resource(nullptr) {}
+
+        /**
+         * Initializes an empty list whose nodes come from the given memory resource.
+         * @param resource The memory resource, or nullptr for the global heap.
+         */
+        explicit List(std::pmr::memory_resource* resource) : m_head(nullptr), m_tail(nullptr), m_size(0), m_resource(resource) {}
+
+        /**
+         * Copy constructor, copies every element in order.
+         * @param other The list to copy.
+         * @param resource The memory resource for the copy, or nullptr for the global heap.
+         */
+        List(const List& other, std::pmr::memory_resource* resource = nullptr)
+            : m_head(nullptr), m_tail(nullptr), m_size(0), m_resource(resource)
+        {
+            for (Node* current = other.m_head; current; current = current->m_next)
+                push_back(current->m_data);
+        }
+
+        /**
+         * Move constructor, takes over the nodes (and memory resource) of another list.
+         * @param other The list to move from (left empty).
+         */
+        List(List&& other) noexcept
+            : m_head(other.m_head), m_tail(other.m_tail), m_size(other.m_size), m_resource(other.m_resource)
+        {
+            other.m_head = other.m_tail = nullptr;
+            other.m_size = 0;
+        }
+
+        /**
+         * Copy assignment, the copy's nodes come from this list's memory resource.
+         * @param other The list to copy.
+         * @return A reference to this list.
+         */
+        List& operator=(const List& other)
+        {
+            if (this != &other)
+            {
+                List copy(other, m_resource);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        /**
+         * Move assignment, takes over the nodes (and memory resource) of another list.
+         * @param other The list to move from (left empty).
+         * @return A reference to this list.
+         */
+        List& operator=(List&& other) noexcept
+        {
+            if (this != &other)
+            {
+                List moved(static_cast<List&&>(other));
+                swap(moved);
+            }
+            return *this;
+        }
 
         /**
          * Destructor, deletes all elements in the list.
@@ -45,13 +112,42 @@ namespace mylib
             clear();
         }
 
+        /**
+         * Swaps the contents of two lists; each list's memory resource travels with its nodes.
+         * @param other The list to swap with.
+         */
+        void swap(List& other) noexcept
+        {
+            Node* head = m_head;
+            Node* tail = m_tail;
+            size_t size = m_size;
+            std::pmr::memory_resource* resource = m_resource;
+            m_head = other.m_head;
+            m_tail = other.m_tail;
+            m_size = other.m_size;
+            m_resource = other.m_resource;
+            other.m_head = head;
+            other.m_tail = tail;
+            other.m_size = size;
+            other.m_resource = resource;
+        }
+
+        /**
+         * Gets the memory resource the nodes come from.
+         * @return The resource, or nullptr for the global heap.
+         */
+        std::pmr::memory_resource* resource() const
+        {
+            return m_resource;
+        }
+
         /**
          * Adds an element to the end of the list.
          * @param value The value to be added.
          */
         void push_back(const T& value)
         {
-            Node* newNode = new Node(value);
+            Node* newNode = memory::create<Node>(m_resource, value);
             if (!m_tail)
                 m_head = m_tail = newNode;
             else
@@ -69,7 +165,7 @@ namespace mylib
          */
         void push_front(const T& value)
         {
-            Node* newNode = new Node(value);
+            Node* newNode = memory::create<Node>(m_resource, value);
             if (!m_head)
                 m_head = m_tail = newNode;
             else
@@ -94,7 +190,7 @@ namespace mylib
                     m_tail->m_next = nullptr;
                 else
                     m_head = nullptr;
-                delete temp;
+                memory::destroy(m_resource, temp);
                 m_size--;
             }
         }
@@ -112,7 +208,7 @@ namespace mylib
                     m_head->m_prev = nullptr;
                 else
                     m_tail = nullptr;
-                delete temp;
+                memory::destroy(m_resource, temp);
                 m_size--;
             }
         }
@@ -189,7 +285,7 @@ namespace mylib
                     else
                         m_tail = current->m_prev;
                     current = current->m_next;
-                    delete toDelete;
+                    memory::destroy(m_resource, toDelete);
                     m_size--;
                 }
                 else
@@ -413,13 +509,13 @@ namespace mylib
          */
         void insert(Iterator pos, const T& value)
         {
-            Node* newNode = new Node(value);
             if (pos == begin())
                 push_front(value);
             else if (pos == end())
                 push_back(value);
             else
             {
+                Node* newNode = memory::create<Node>(m_resource, value);
                 Node* current = pos.m_current;
                 newNode->m_next = current;
                 newNode->m_prev = current->m_prev;
@@ -446,7 +542,7 @@ namespace mylib
                     current->m_next->m_prev = current->m_prev;
                 else
                     m_tail = current->m_prev;
-                delete current;
+                memory::destroy(m_resource, current);
                 m_size--;
             }
         }
@@ -1,22 +1,416 @@
 #ifndef MYLIB_MATRIX_H
 #define MYLIB_MATRIX_H
 
+#include <atomic>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 #include "MyArray.h"
+#include "MyGemm.h"
+#include "MyParallel.h"
+#include "MyReduce.h"
 #include "sstream"
 
 namespace mylib {
+    namespace detail
+    {
+#ifdef __SIZEOF_INT128__
+        /// 128-bit integer for the exact determinant fallback (__extension__ keeps -Wpedantic quiet).
+        __extension__ using int128 = __int128;
+#endif
+
+        /**
+         * Checks whether a value survives a round trip through another integral type.
+         * @tparam To The destination type.
+         * @tparam From The source type.
+         * @param value The value to test.
+         * @return True if the value is representable in To.
+         */
+        template <typename To, typename From>
+        bool fitsIn(From value)
+        {
+            To narrowed = static_cast<To>(value);
+            return static_cast<From>(narrowed) == value && ((narrowed < To{}) == (value < From{}));
+        }
+
+        /**
+         * Computes a * b - c * d for a signed integral type, detecting overflow.
+         * @param out Receives the result when no overflow occurred.
+         * @return True if any intermediate step overflowed.
+         */
+        template <typename W>
+        bool mulSubOverflows(W a, W b, W c, W d, W& out)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            W ab, cd;
+            return __builtin_mul_overflow(a, b, &ab)
+                || __builtin_mul_overflow(c, d, &cd)
+                || __builtin_sub_overflow(ab, cd, &out);
+#else
+            const W maxValue = std::numeric_limits<W>::max();
+            const W minValue = std::numeric_limits<W>::min();
+            auto mulOverflows = [&](W x, W y, W& product)
+            {
+                if (x > 0 ? (y > 0 ? x > maxValue / y : y < minValue / x)
+                          : (y > 0 ? x < minValue / y : (x != 0 && y < maxValue / x)))
+                    return true;
+                product = x * y;
+                return false;
+            };
+            W ab, cd;
+            if (mulOverflows(a, b, ab) || mulOverflows(c, d, cd))
+                return true;
+            if ((cd < 0 && ab > maxValue + cd) || (cd > 0 && ab < minValue + cd))
+                return true;
+            out = ab - cd;
+            return false;
+#endif
+        }
+
+        /**
+         * Transposes an n x n buffer into another one tile by tile, so both the
+         * reads and the writes stay within a few cache lines per tile.
+         * @param src The source buffer.
+         * @param dst The destination buffer (must not alias src).
+         * @param n The matrix dimension.
+         */
+        template <typename T>
+        void blockedTranspose(const T* src, T* dst, size_t n)
+        {
+            constexpr size_t block = 32;
+            for (size_t ii = 0; ii < n; ii += block)
+            {
+                const size_t iEnd = ii + block < n ? ii + block : n;
+                for (size_t jj = 0; jj < n; jj += block)
+                {
+                    const size_t jEnd = jj + block < n ? jj + block : n;
+                    for (size_t i = ii; i < iEnd; ++i)
+                        for (size_t j = jj; j < jEnd; ++j)
+                            dst[j * n + i] = src[i * n + j];
+                }
+            }
+        }
+    }
+
+    /**
+     * Layout policy storing a matrix row by row: rows are contiguous.
+     */
+    struct RowMajor
+    {
+        static constexpr bool rowsContiguous = true;
+
+        /**
+         * Maps a (row, col) position to its offset in the storage.
+         * @param row Row index.
+         * @param col Column index.
+         * @param size The matrix dimension.
+         * @return The storage offset.
+         */
+        static constexpr size_t index(size_t row, size_t col, size_t size)
+        {
+            return row * size + col;
+        }
+    };
+
+    /**
+     * Layout policy storing a matrix column by column: columns are contiguous.
+     */
+    struct ColMajor
+    {
+        static constexpr bool rowsContiguous = false;
+
+        /**
+         * Maps a (row, col) position to its offset in the storage.
+         * @param row Row index.
+         * @param col Column index.
+         * @param size The matrix dimension.
+         * @return The storage offset.
+         */
+        static constexpr size_t index(size_t row, size_t col, size_t size)
+        {
+            return col * size + row;
+        }
+    };
+
+    /**
+     * Cache hit/miss counters for the derived results of a Matrix.
+     */
+    struct MatrixCacheStats
+    {
+        size_t hits;    ///< Requests answered from the cache.
+        size_t misses;  ///< Requests that had to compute the result.
+    };
+
+    /**
+     * LU factorization with partial pivoting, P A = L U.
+     * L (unit lower triangular, diagonal implied) and U are packed row-major in one buffer.
+     * @tparam T Type of the matrix elements (a floating-point type).
+     */
+    template <typename T>
+    struct LUDecomposition
+    {
+        size_t size = 0;            ///< Dimension of the factored matrix.
+        Array<T> factors;           ///< L below the diagonal, U on and above it.
+        Array<size_t> permutation;  ///< Row i of P A is row permutation[i] of A.
+        bool negated = false;       ///< True if P is an odd permutation.
+        bool singular = false;      ///< True if a zero pivot was met.
+
+        /**
+         * Factors an n x n matrix given row-major.
+         * @param values The matrix elements, row-major.
+         * @param n The matrix dimension.
+         */
+        LUDecomposition(Array<T> values, size_t n) : size(n), factors(std::move(values)), permutation(n)
+        {
+            T* a = factors.dataPointer();
+            size_t* perm = permutation.dataPointer();
+            for (size_t i = 0; i < n; ++i)
+                perm[i] = i;
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                size_t pivotRow = k;
+                for (size_t i = k + 1; i < n; ++i)
+                    if (simd::absValue(a[i * n + k]) > simd::absValue(a[pivotRow * n + k]))
+                        pivotRow = i;
+                if (a[pivotRow * n + k] == T(0))
+                {
+                    singular = true;
+                    continue;
+                }
+                if (pivotRow != k)
+                {
+                    for (size_t j = 0; j < n; ++j)
+                        std::swap(a[k * n + j], a[pivotRow * n + j]);
+                    std::swap(perm[k], perm[pivotRow]);
+                    negated = !negated;
+                }
+
+                const T* pivot = a + k * n;
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    T* row = a + i * n;
+                    row[k] /= pivot[k];
+                    const T factor = row[k];
+                    for (size_t j = k + 1; j < n; ++j)
+                        row[j] -= factor * pivot[j];
+                }
+            }
+        }
+
+        /**
+         * Computes the determinant from the factors.
+         * @return The determinant of the factored matrix.
+         */
+        T determinant() const
+        {
+            if (singular)
+                return T(0);
+            const T* a = factors.dataPointer();
+            T det = T(1);
+            for (size_t i = 0; i < size; ++i)
+                det *= a[i * size + i];
+            return negated ? -det : det;
+        }
+
+        /**
+         * Solves A x = b in place.
+         * @param b The right-hand side, overwritten with the solution.
+         * @throws "Matrix is singular" if the factored matrix is singular.
+         */
+        void solveInPlace(T* b) const
+        {
+            if (singular)
+                throw "Matrix is singular";
+            const T* a = factors.dataPointer();
+            const size_t* perm = permutation.dataPointer();
+            Array<T> y(size);
+            T* x = y.dataPointer();
+            for (size_t i = 0; i < size; ++i)
+            {
+                T value = b[perm[i]];
+                for (size_t j = 0; j < i; ++j)
+                    value -= a[i * size + j] * x[j];
+                x[i] = value;
+            }
+            for (size_t i = size; i-- > 0;)
+            {
+                T value = x[i];
+                for (size_t j = i + 1; j < size; ++j)
+                    value -= a[i * size + j] * x[j];
+                x[i] = value / a[i * size + i];
+            }
+            for (size_t i = 0; i < size; ++i)
+                b[i] = x[i];
+        }
+    };
+
     /**
      * Represents a square matrix of type T.
+     *
+     * Copies share their storage until one of them is written to (copy-on-write),
+     * and transpose() only flips a flag that the kernels honor, so both are O(1).
+     * Mutable references, pointers and iterators (from operator(), at() and the
+     * mutable iterators) are invalidated by copying the matrix, including through
+     * transpose() and toLayout(): the copy shares the storage they point into, so
+     * writing through them afterwards would change the copy too. Take them again
+     * after the copy; that unshares the storage first.
+     *
+     * Const member functions never replace the storage, so they may run concurrently.
+     * Const readers that need a lazily transposed matrix in Layout order share a
+     * transposed copy, built once and published atomically; it lives until the
+     * matrix is modified, and a later materialization adopts it.
+     *
+     * Each matrix keeps a modification version, bumped by every mutable access
+     * (operator(), fill, the mutable iterators). determinant(), lu() and inverse()
+     * are cached until the version changes, so a cache hit is O(1). Writing
+     * through a reference or pointer held across one of those calls is not
+     * tracked: take the reference again after the call (which bumps the version)
+     * before writing. The cache is guarded by a mutex, so these queries may also
+     * run concurrently on one matrix.
      * @tparam T Type of elements in the matrix.
+     * @tparam Layout Storage order policy, RowMajor (default) or ColMajor.
      */
-    template <typename T>
+    template <typename T, typename Layout = RowMajor>
     class Matrix {
+        template <typename, typename>
+        friend class Matrix;
+
     public:
         /**
          * Constructor that initializes a matrix of the given size.
          * @param size The size of the matrix (number of rows and columns).
          */
-        Matrix(size_t size) : m_size(size), m_data(size* size) {}
+        Matrix(size_t size) : m_size(size), m_data(makeStorage(size * size, true, nullptr)), m_transposed(false) {}
+
+        /**
+         * Constructor that initializes a matrix whose storage comes from a memory resource.
+         * Matrices computed from this one allocate from the same resource.
+         * @param size The size of the matrix (number of rows and columns).
+         * @param resource The memory resource, or nullptr for the global heap.
+         */
+        Matrix(size_t size, std::pmr::memory_resource* resource)
+            : m_size(size), m_data(makeStorage(size * size, true, resource)), m_transposed(false) {}
+
+        /**
+         * Constructor that allocates a matrix of the given size without zeroing it.
+         * The elements are indeterminate for trivial types until written.
+         * @param size The size of the matrix (number of rows and columns).
+         * @param resource The memory resource, or nullptr for the global heap.
+         */
+        Matrix(size_t size, Uninitialized, std::pmr::memory_resource* resource = nullptr)
+            : m_size(size), m_data(makeStorage(size * size, false, resource)), m_transposed(false) {}
+
+        /**
+         * Copy constructor. Shares the storage until either matrix is written to;
+         * mutable references obtained from the source before are invalidated.
+         * @param other The matrix to copy.
+         */
+        Matrix(const Matrix& other)
+            : m_size(other.m_size), m_data(other.m_data), m_transposed(other.m_transposed),
+              m_canonical(other.m_canonical.load(std::memory_order_acquire)), m_version(other.m_version), m_cache(other.cacheCopy()) {}
+
+        /**
+         * Move constructor. References obtained from the source stay valid and now refer to this matrix.
+         * @param other The matrix to move from.
+         */
+        Matrix(Matrix&& other) noexcept
+            : m_size(other.m_size), m_data(std::move(other.m_data)), m_transposed(other.m_transposed),
+              m_canonical(other.m_canonical.exchange(nullptr)),
+              m_version(other.m_version), m_cache(std::move(other.m_cache)) {}
+
+        /**
+         * Copy assignment, sharing the storage like the copy constructor.
+         * References obtained from this matrix before are invalidated.
+         * @param other The matrix to copy.
+         * @return This matrix.
+         */
+        Matrix& operator=(const Matrix& other)
+        {
+            if (this != &other)
+                *this = Matrix(other);
+            return *this;
+        }
+
+        /**
+         * Move assignment. References obtained from this matrix before are invalidated.
+         * @param other The matrix to move from.
+         * @return This matrix.
+         */
+        Matrix& operator=(Matrix&& other) noexcept
+        {
+            if (this == &other)
+                return *this;
+            m_size = other.m_size;
+            m_data = std::move(other.m_data);
+            m_transposed = other.m_transposed;
+            m_canonical.store(other.m_canonical.exchange(nullptr));
+            m_version = other.m_version;
+            m_cache = std::move(other.m_cache);
+            return *this;
+        }
+
+        /**
+         * Gets the memory resource backing the storage.
+         * @return The resource, or nullptr for the global heap.
+         */
+        std::pmr::memory_resource* resource() const
+        {
+            return m_data ? m_data->resource() : nullptr;
+        }
+
+        /**
+         * Creates a matrix backed by a memory-mapped binary file of n * n raw elements in
+         * Layout order (as written by writeToFile()). Pages fault in on first access. A
+         * read-only mapping is copied to regular storage on the first write.
+         * @param path The file to map.
+         * @param mode ReadOnly or CopyOnWrite (see Array::mapFile()).
+         * @return The matrix.
+         * @throws "Cannot map file" if the file cannot be opened or mapped.
+         * @throws "File does not hold a square matrix" if the element count is not a square.
+         */
+        static Matrix mapFile(const std::string& path, memory::FileMapping mode = memory::FileMapping::ReadOnly)
+        {
+            auto data = std::make_shared<Array<T>>(Array<T>::mapFile(path, mode));
+            const size_t count = data->getSize();
+            size_t n = static_cast<size_t>(std::sqrt(static_cast<double>(count)));
+            while (n * n > count)
+                --n;
+            while ((n + 1) * (n + 1) <= count)
+                ++n;
+            if (n * n != count)
+                throw "File does not hold a square matrix";
+            return Matrix(n, std::move(data), false);
+        }
+
+        /**
+         * Writes the elements in Layout order to a binary file that mapFile() can load.
+         * @param path The file to write.
+         * @throws "Cannot write file" if the file cannot be written.
+         */
+        void writeToFile(const std::string& path) const
+        {
+            canonicalArray().writeToFile(path);
+        }
+
+        /**
+         * Gets how the storage is backed, e.g. whether it ended up on huge pages.
+         * @return The page backing of the storage.
+         */
+        memory::PageBacking pageBacking() const
+        {
+            return m_data ? m_data->pageBacking() : memory::PageBacking::Heap;
+        }
 
         /**
          * Overloads the output stream operator to print the matrix.
@@ -24,12 +418,12 @@ namespace mylib {
          * @param mat Matrix to be printed.
          * @return The output stream.
          */
-        friend std::ostream& operator<<(std::ostream& os, const Matrix<T>& mat)
+        friend std::ostream& operator<<(std::ostream& os, const Matrix& mat)
         {
             for (size_t i = 0; i < mat.m_size; ++i)
             {
                 for (size_t j = 0; j < mat.m_size; ++j)
-                    os << mat.m_data[i * mat.m_size + j] << " ";
+                    os << mat.storage()[mat.offset(i, j)] << " ";
                 os << "\n";
             }
             return os;
@@ -37,30 +431,62 @@ namespace mylib {
 
         /**
          * Accessor for the matrix element at the given row and column.
+         * The indices are only checked when MYLIB_BOUNDS_CHECK is enabled (debug builds).
          * @param row Row index.
          * @param col Column index.
          * @return Reference to the element at the specified position.
-         * @throws "Index out of range" if indices are out of bounds.
+         * @throws "Index out of range" if checking is enabled and indices are out of bounds.
          */
         T& operator()(size_t row, size_t col)
         {
-            if (row >= m_size || col >= m_size)
-                throw "Index out of range";
-            return m_data[row * m_size + col];
+            detail::checkIndex(row, m_size);
+            detail::checkIndex(col, m_size);
+            T* data = writableStorage();
+            return data[offset(row, col)];
         }
 
         /**
          * Const accessor for the matrix element at the given row and column.
+         * The indices are only checked when MYLIB_BOUNDS_CHECK is enabled (debug builds).
          * @param row Row index.
          * @param col Column index.
          * @return Constant reference to the element at the specified position.
-         * @throws "Index out of range" if indices are out of bounds.
+         * @throws "Index out of range" if checking is enabled and indices are out of bounds.
          */
         const T& operator()(size_t row, size_t col) const
         {
-            if (row >= m_size || col >= m_size)
-                throw "Index out of range";
-            return m_data[row * m_size + col];
+            detail::checkIndex(row, m_size);
+            detail::checkIndex(col, m_size);
+            return storage()[offset(row, col)];
+        }
+
+        /**
+         * Accessor for the matrix element at the given row and column, always bounds-checked.
+         * @param row Row index.
+         * @param col Column index.
+         * @return Reference to the element at the specified position.
+         * @throws "Index out of range" if indices are out of bounds.
+         */
+        T& at(size_t row, size_t col)
+        {
+            detail::checkIndexAlways(row, m_size);
+            detail::checkIndexAlways(col, m_size);
+            T* data = writableStorage();
+            return data[offset(row, col)];
+        }
+
+        /**
+         * Const accessor for the matrix element at the given row and column, always bounds-checked.
+         * @param row Row index.
+         * @param col Column index.
+         * @return Constant reference to the element at the specified position.
+         * @throws "Index out of range" if indices are out of bounds.
+         */
+        const T& at(size_t row, size_t col) const
+        {
+            detail::checkIndexAlways(row, m_size);
+            detail::checkIndexAlways(col, m_size);
+            return storage()[offset(row, col)];
         }
 
         /**
@@ -78,7 +504,31 @@ namespace mylib {
          */
         void fill(const T& value)
         {
-            m_data.fill(value);
+            ++m_version;
+            if (m_data.use_count() > 1 || m_data->isReadOnly())
+                m_data = makeStorage(m_size * m_size, false, resource());
+            m_data->fill(value);
+            m_transposed = false;
+            m_canonical.store(nullptr);
+        }
+
+        /**
+         * Checks whether the matrix is a lazily transposed view of its storage.
+         * @return True if the storage holds the transpose of this matrix.
+         */
+        bool isTransposed() const
+        {
+            return m_transposed;
+        }
+
+        /**
+         * Checks whether two matrices currently share the same storage.
+         * @param other The matrix to compare with.
+         * @return True if no copy has been made between the two yet.
+         */
+        bool sharesStorageWith(const Matrix& other) const
+        {
+            return m_data == other.m_data;
         }
 
         /**
@@ -90,9 +540,11 @@ namespace mylib {
         Array<T> getRow(size_t row) const
         {
             if (row >= m_size) throw "Index out of range";
-            Array<T> result(m_size);
+            Array<T> result(m_size, uninitialized);
+            const T* src = storage();
+            T* dst = result.dataPointer();
             for (size_t i = 0; i < m_size; ++i)
-                result[i] = (*this)(row, i);
+                dst[i] = src[offset(row, i)];
             return result;
         }
 
@@ -105,86 +557,197 @@ namespace mylib {
         Array<T> getCol(size_t col) const
         {
             if (col >= m_size) throw "Index out of range";
-            Array<T> result(m_size);
+            Array<T> result(m_size, uninitialized);
+            const T* src = storage();
+            T* dst = result.dataPointer();
             for (size_t i = 0; i < m_size; ++i)
-                result[i] = (*this)(i, col);
+                dst[i] = src[offset(i, col)];
+            return result;
+        }
+
+        /**
+         * Builds a copy of this matrix stored in another layout.
+         * The storage of one layout is the transpose of the other's, so the
+         * conversion is a single blocked transpose of the buffer, or no copy
+         * at all when the storage is already in the target order.
+         * @tparam Target The layout of the returned matrix.
+         * @return The same matrix in the Target layout.
+         */
+        template <typename Target>
+        Matrix<T, Target> toLayout() const
+        {
+            if (storedRowMajor() == Target::rowsContiguous)
+                return Matrix<T, Target>(m_size, m_data, false);
+            Matrix<T, Target> result(m_size, uninitialized, resource());
+            detail::blockedTranspose(storage(), result.m_data->dataPointer(), m_size);
             return result;
         }
 
-        // Iterators for traversing the matrix.
+        // Iterators for traversing the matrix (begin/end walk the storage order).
+        // The mutable ones materialize a pending lazy transpose and unshare the storage;
+        // the const ones read a Layout-order copy instead.
 
         T* begin()
         {
-            return m_data.data();
+            return writableStorage();
         }
 
         T* end()
         {
-            return m_data.data() + (m_size * m_size);
+            return writableStorage() + (m_size * m_size);
         }
 
         const T* getBegin() const
         {
-            return m_data.data();
+            return canonicalStorage();
         }
 
         const T* getEnd() const
         {
-            return m_data.data() + (m_size * m_size);
+            return canonicalStorage() + (m_size * m_size);
+        }
+
+        // Const overloads so const matrices work with range-for and the standard algorithms
+        // (pointers are contiguous iterators).
+
+        const T* begin() const
+        {
+            return getBegin();
+        }
+
+        const T* end() const
+        {
+            return getEnd();
         }
 
         T* rowBegin(size_t row)
+            requires Layout::rowsContiguous
         {
-            return &m_data[row * m_size];
+            return writableStorage() + row * m_size;
         }
 
         T* rowEnd(size_t row)
+            requires Layout::rowsContiguous
         {
-            return &m_data[row * m_size + m_size];
+            return writableStorage() + row * m_size + m_size;
         }
 
         const T* rowBegin(size_t row) const
+            requires Layout::rowsContiguous
         {
-            return &m_data[row * m_size];
+            return canonicalStorage() + row * m_size;
         }
 
         const T* rowEnd(size_t row) const
+            requires Layout::rowsContiguous
         {
-            return &m_data[row * m_size + m_size];
+            return canonicalStorage() + row * m_size + m_size;
         }
 
-        // Column iterator for iterating over columns.
+        // Column iterator for iterating over columns (a random-access iterator).
+        // The stride is the matrix size in RowMajor layout and 1 in ColMajor layout.
+        // It keeps the column start and a row index, so the end iterator never points past the storage.
 
-        class ColumnIterator {
+        template <typename U>
+        class BasicColumnIterator {
         public:
-            ColumnIterator(T* ptr, size_t stride) : m_ptr(ptr), m_stride(stride) {}
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_cv_t<U>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = U*;
+            using reference = U&;
+
+            BasicColumnIterator() : m_base(nullptr), m_row(0), m_stride(1) {}
 
-            T& operator*()
+            BasicColumnIterator(U* base, size_t row, size_t stride)
+                : m_base(base), m_row(static_cast<difference_type>(row)), m_stride(static_cast<difference_type>(stride)) {}
+
+            U& operator*() const
+            {
+                return m_base[m_row * m_stride];
+            }
+
+            U* operator->() const
+            {
+                return m_base + m_row * m_stride;
+            }
+
+            U& operator[](difference_type offset) const
+            {
+                return m_base[(m_row + offset) * m_stride];
+            }
+
+            BasicColumnIterator& operator++()
+            {
+                ++m_row; return *this;
+            }
+
+            BasicColumnIterator operator++(int)
             {
-                return *m_ptr;
+                BasicColumnIterator tmp = *this; ++(*this);
+                return tmp;
             }
 
-            ColumnIterator& operator++()
+            BasicColumnIterator& operator--()
             {
-                m_ptr += m_stride; return *this;
+                --m_row; return *this;
             }
 
-            ColumnIterator operator++(int)
+            BasicColumnIterator operator--(int)
             {
-                ColumnIterator tmp = *this; ++(*this);
+                BasicColumnIterator tmp = *this; --(*this);
                 return tmp;
             }
 
-            bool operator!=(const ColumnIterator& other) const
+            BasicColumnIterator& operator+=(difference_type offset)
             {
-                return m_ptr != other.m_ptr;
+                m_row += offset; return *this;
+            }
+
+            BasicColumnIterator& operator-=(difference_type offset)
+            {
+                m_row -= offset; return *this;
+            }
+
+            friend BasicColumnIterator operator+(BasicColumnIterator it, difference_type offset)
+            {
+                return it += offset;
+            }
+
+            friend BasicColumnIterator operator+(difference_type offset, BasicColumnIterator it)
+            {
+                return it += offset;
+            }
+
+            friend BasicColumnIterator operator-(BasicColumnIterator it, difference_type offset)
+            {
+                return it -= offset;
+            }
+
+            friend difference_type operator-(const BasicColumnIterator& lhs, const BasicColumnIterator& rhs)
+            {
+                return lhs.m_row - rhs.m_row;
+            }
+
+            friend bool operator==(const BasicColumnIterator& lhs, const BasicColumnIterator& rhs)
+            {
+                return lhs.m_base == rhs.m_base && lhs.m_row == rhs.m_row;
+            }
+
+            friend std::strong_ordering operator<=>(const BasicColumnIterator& lhs, const BasicColumnIterator& rhs)
+            {
+                return lhs.m_row <=> rhs.m_row;
             }
 
         private:
-            T* m_ptr;
-            size_t m_stride;
+            U* m_base;
+            difference_type m_row;
+            difference_type m_stride;
         };
 
+        using ColumnIterator = BasicColumnIterator<T>;
+        using ConstColumnIterator = BasicColumnIterator<const T>;
+
         /**
          * Returns an iterator for the start of a column.
          * @param col The column index.
@@ -192,7 +755,7 @@ namespace mylib {
          */
         ColumnIterator colBegin(size_t col)
         {
-            return ColumnIterator(&m_data[col], m_size);
+            return ColumnIterator(writableStorage() + Layout::index(0, col, m_size), 0, columnStride());
         }
 
         /**
@@ -202,7 +765,7 @@ namespace mylib {
          */
         ColumnIterator colEnd(size_t col)
         {
-            return ColumnIterator(&m_data[col + m_size * (m_size - 1) + 1], m_size);
+            return ColumnIterator(writableStorage() + Layout::index(0, col, m_size), m_size, columnStride());
         }
 
         /**
@@ -210,9 +773,9 @@ namespace mylib {
          * @param col The column index.
          * @return Constant iterator pointing to the first element of the column.
          */
-        const ColumnIterator colBegin(size_t col) const
+        ConstColumnIterator colBegin(size_t col) const
         {
-            return ColumnIterator(&m_data[col], m_size);
+            return ConstColumnIterator(canonicalStorage() + Layout::index(0, col, m_size), 0, columnStride());
         }
 
         /**
@@ -220,9 +783,9 @@ namespace mylib {
          * @param col The column index.
          * @return Constant iterator pointing past the last element of the column.
          */
-        const ColumnIterator colEnd(size_t col) const
+        ConstColumnIterator colEnd(size_t col) const
         {
-            return ColumnIterator(&m_data[col + m_size * (m_size - 1) + 1], m_size);
+            return ConstColumnIterator(canonicalStorage() + Layout::index(0, col, m_size), m_size, columnStride());
         }
 
         // Operator overloads for matrix operations.
@@ -237,10 +800,7 @@ namespace mylib {
         {
             if (m_size != other.m_size)
                 throw "Matrix sizes do not match";
-            Matrix result(m_size);
-            for (size_t i = 0; i < m_size * m_size; ++i)
-                result.m_data[i] = m_data[i] + other.m_data[i];
-            return result;
+            return elementwise(other, [](const T& a, const T& b) { return a + b; });
         }
 
         /**
@@ -253,14 +813,12 @@ namespace mylib {
         {
             if (m_size != other.m_size)
                 throw "Matrix sizes do not match";
-            Matrix result(m_size);
-            for (size_t i = 0; i < m_size * m_size; ++i)
-                result.m_data[i] = m_data[i] - other.m_data[i];
-            return result;
+            return elementwise(other, [](const T& a, const T& b) { return a - b; });
         }
 
         /**
-         * Multiplies this matrix by another matrix.
+         * Multiplies this matrix by another matrix with the cache-blocked kernel.
+         * Block sizes come from the GEMM profile for T (see gemm::blocking()).
          * @param other The matrix to multiply by.
          * @return A new matrix containing the result.
          * @throws "Matrix sizes do not match" if the matrices have different sizes.
@@ -269,16 +827,23 @@ namespace mylib {
         {
             if (m_size != other.m_size)
                 throw "Matrix sizes do not match";
-            Matrix result(m_size);
-            for (size_t i = 0; i < m_size; ++i)
-            {
-                for (size_t j = 0; j < m_size; ++j)
-                {
-                    result(i, j) = 0;
-                    for (size_t k = 0; k < m_size; ++k)
-                        result(i, j) += (*this)(i, k) * other(k, j);
-                }
-            }
+            Matrix result(m_size, uninitialized, resource());
+            // Small products fit in cache whole; skip the profile lookup for them.
+            const GemmBlocking blocking = m_size <= kSmallGemmSize
+                ? GemmBlocking{ kSmallGemmSize, kSmallGemmSize, kSmallGemmSize }
+                : gemm::blocking<T>();
+            // Operands stored in different orders are both read in Layout order.
+            const bool mixed = storedRowMajor() != other.storedRowMajor();
+            const T* lhs = mixed ? canonicalStorage() : storage();
+            const T* rhs = mixed ? other.canonicalStorage() : other.storage();
+            // Column-ordered storage holds the transposes, and (AB)^T = B^T A^T;
+            // the product then comes out column-ordered too.
+            const bool rowOrdered = mixed ? Layout::rowsContiguous : storedRowMajor();
+            if (rowOrdered)
+                gemm::multiply(lhs, rhs, result.m_data->dataPointer(), m_size, blocking);
+            else
+                gemm::multiply(rhs, lhs, result.m_data->dataPointer(), m_size, blocking);
+            result.m_transposed = rowOrdered != Layout::rowsContiguous;
             return result;
         }
 
@@ -289,9 +854,12 @@ namespace mylib {
          */
         Matrix operator*(const T& scalar) const
         {
-            Matrix result(m_size);
+            Matrix result(m_size, uninitialized, resource());
+            const T* src = storage();
+            T* dst = result.m_data->dataPointer();
             for (size_t i = 0; i < m_size * m_size; ++i)
-                result.m_data[i] = m_data[i] * scalar;
+                dst[i] = src[i] * scalar;
+            result.m_transposed = m_transposed;
             return result;
         }
 
@@ -304,37 +872,353 @@ namespace mylib {
         {
             if (m_size != other.m_size)
                 return false;
+            if constexpr (simd::kBitwiseComparable<T>)
+            {
+                // Only where == is reflexive: a NaN (also inside std::complex) never equals itself.
+                if (m_data == other.m_data && m_transposed == other.m_transposed)
+                    return true;
+            }
+            const bool mixed = m_transposed != other.m_transposed;
+            const T* lhs = mixed ? canonicalStorage() : storage();
+            const T* rhs = mixed ? other.canonicalStorage() : other.storage();
             for (size_t i = 0; i < m_size * m_size; ++i)
             {
-                if (m_data[i] != other.m_data[i])
+                if (lhs[i] != rhs[i])
                     return false;
             }
             return true;
         }
 
         /**
-         * Transposes the matrix.
-         * @return A new matrix containing the transpose.
+         * Transposes the matrix lazily: the result shares this matrix's storage
+         * with the transposed flag flipped, and is only materialized (with a
+         * blocked transpose) if a kernel needs the storage in canonical order.
+         * @return A matrix containing the transpose.
          */
         Matrix transpose() const
         {
-            Matrix result(m_size);
+            Matrix result(*this);
+            result.m_transposed = !m_transposed;
+            result.m_canonical.store(nullptr);
+            return result;
+        }
+
+        // Reductions. Large matrices are reduced on several threads.
+
+        /**
+         * Sums all elements of the matrix.
+         * @return The sum of the elements.
+         */
+        T sum() const
+        {
+            return reduce::sum(storage(), m_size * m_size);
+        }
+
+        /**
+         * Gets the smallest element of the matrix.
+         * @return The minimum.
+         * @throws "Matrix is empty" if the matrix has no elements.
+         */
+        T min() const
+        {
+            if (m_size == 0)
+                throw "Matrix is empty";
+            return reduce::minValue(storage(), m_size * m_size);
+        }
+
+        /**
+         * Gets the largest element of the matrix.
+         * @return The maximum.
+         * @throws "Matrix is empty" if the matrix has no elements.
+         */
+        T max() const
+        {
+            if (m_size == 0)
+                throw "Matrix is empty";
+            return reduce::maxValue(storage(), m_size * m_size);
+        }
+
+        /**
+         * Locates the smallest element of the matrix (first in storage order on ties).
+         * @return The (row, column) position of the minimum.
+         * @throws "Matrix is empty" if the matrix has no elements.
+         */
+        std::pair<size_t, size_t> argmin() const
+        {
+            if (m_size == 0)
+                throw "Matrix is empty";
+            return positionOf(reduce::argMin(storage(), m_size * m_size));
+        }
+
+        /**
+         * Locates the largest element of the matrix (first in storage order on ties).
+         * @return The (row, column) position of the maximum.
+         * @throws "Matrix is empty" if the matrix has no elements.
+         */
+        std::pair<size_t, size_t> argmax() const
+        {
+            if (m_size == 0)
+                throw "Matrix is empty";
+            return positionOf(reduce::argMax(storage(), m_size * m_size));
+        }
+
+        /**
+         * Computes the trace (sum of the diagonal elements).
+         * @return The trace.
+         */
+        T trace() const
+        {
+            const T* data = storage();
+            T result = T(0);
             for (size_t i = 0; i < m_size; ++i)
+                result += data[i * (m_size + 1)];
+            return result;
+        }
+
+        /**
+         * Computes the Frobenius norm (square root of the sum of squared elements).
+         * @return The Frobenius norm.
+         */
+        T frobeniusNorm() const
+        {
+            return static_cast<T>(std::sqrt(reduce::sumSquares(storage(), m_size * m_size)));
+        }
+
+        /**
+         * Computes the 1-norm (largest absolute column sum).
+         * @return The 1-norm.
+         */
+        T norm1() const
+        {
+            return storedRowMajor() ? maxCrossAbsSum() : maxLineAbsSum();
+        }
+
+        /**
+         * Computes the infinity norm (largest absolute row sum).
+         * @return The infinity norm.
+         */
+        T normInf() const
+        {
+            return storedRowMajor() ? maxLineAbsSum() : maxCrossAbsSum();
+        }
+
+        /**
+         * Computes the determinant of the matrix: exactly by Bareiss elimination for
+         * integral types, from the cached LU factors otherwise.
+         * The result is cached until the matrix is modified.
+         * @return The determinant.
+         */
+        T determinant() const
+        {
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+            DerivedCache& cache = validCache();
+            if (cache.hasDeterminant)
+                ++cache.stats.hits;
+            else
+                ++cache.stats.misses;
+            return cachedDeterminant(cache);
+        }
+
+        /**
+         * Gets the LU factorization (with partial pivoting) of the matrix.
+         * The factors are cached until the matrix is modified.
+         * @return The factorization.
+         */
+        const LUDecomposition<T>& lu() const
+            requires (!std::is_integral_v<T>)
+        {
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+            DerivedCache& cache = validCache();
+            if (cache.lu)
+                ++cache.stats.hits;
+            else
+                ++cache.stats.misses;
+            return cachedLU(cache);
+        }
+
+        /**
+         * Computes the inverse of the matrix, from the LU factors for non-integral
+         * types and from the adjugate otherwise. The result is cached until the
+         * matrix is modified.
+         * @return The inverse matrix.
+         * @throws "Matrix is singular and cannot be inverted" if the matrix cannot be inverted.
+         */
+        Matrix inverse() const
+        {
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+            DerivedCache& cache = validCache();
+            if (cache.inverse)
+            {
+                ++cache.stats.hits;
+                return *cache.inverse;
+            }
+            ++cache.stats.misses;
+
+            Matrix result(m_size);
+            if constexpr (std::is_integral_v<T>)
+            {
+                T det = cachedDeterminant(cache);
+                if (det == 0)
+                    throw "Matrix is singular and cannot be inverted";
+                result = adjugateMatrix() * (static_cast<T>(1) / det);
+            }
+            else
             {
+                const LUDecomposition<T>& factors = cachedLU(cache);
+                if (factors.singular)
+                    throw "Matrix is singular and cannot be inverted";
+                Array<T> column(m_size);
+                T* x = column.dataPointer();
+                T* out = result.m_data->dataPointer();
                 for (size_t j = 0; j < m_size; ++j)
                 {
-                    result(j, i) = (*this)(i, j);
+                    for (size_t i = 0; i < m_size; ++i)
+                        x[i] = i == j ? T(1) : T(0);
+                    factors.solveInPlace(x);
+                    for (size_t i = 0; i < m_size; ++i)
+                        out[Layout::index(i, j, m_size)] = x[i];
                 }
             }
+            cache.inverse = std::make_shared<const Matrix>(result);
             return result;
         }
 
         /**
-         * Computes the determinant of the matrix.
-         * @return The determinant.
-         * @throws "Matrix is singular" if the matrix is singular and cannot be inverted.
+         * Gets the cache statistics of determinant(), lu() and inverse().
+         * @return The hit and miss counters.
          */
-        T determinant() const
+        MatrixCacheStats cacheStats() const
+        {
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+            return m_cache.stats;
+        }
+
+        /**
+         * Resets the cache statistics to zero.
+         */
+        void resetCacheStats()
+        {
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+            m_cache.stats = MatrixCacheStats{ 0, 0 };
+        }
+
+        /**
+         * Gets the modification version of the matrix.
+         * @return A counter bumped by every mutable access.
+         */
+        unsigned long long version() const
+        {
+            return m_version;
+        }
+
+        /**
+         * Prints the matrix to the standard output.
+         */
+        void print() const
+        {
+            for (size_t i = 0; i < m_size; ++i)
+            {
+                for (size_t j = 0; j < m_size; ++j)
+                    std::cout << storage()[offset(i, j)] << " ";
+                std::cout << "\n";
+            }
+        }
+
+    private:
+        static constexpr size_t kSmallGemmSize = 32;   // Products up to this size run as a single block.
+
+        size_t m_size;          // Size of the matrix (number of rows/columns).
+        std::shared_ptr<Array<T>> m_data;   // Storage, shared between copies until written (copy-on-write).
+        bool m_transposed;          // True if the storage holds the transpose of the matrix (lazy transpose).
+        mutable std::atomic<std::shared_ptr<Array<T>>> m_canonical;    // Layout-order copy for const readers of a transposed matrix.
+
+        /**
+         * Derived results cached for one modification version.
+         */
+        struct DerivedCache
+        {
+            unsigned long long version = 0;
+            bool hasDeterminant = false;
+            T determinant{};
+            std::shared_ptr<const LUDecomposition<T>> lu;
+            std::shared_ptr<const Matrix> inverse;
+            MatrixCacheStats stats{ 0, 0 };
+        };
+
+        unsigned long long m_version = 0;   // Modification version, bumped by every mutable access.
+        mutable std::mutex m_cacheMutex;    // Guards m_cache against concurrent const queries.
+        mutable DerivedCache m_cache;       // Derived results, valid while m_cache.version == m_version.
+
+        /**
+         * Copies the cache for a new matrix, under the lock.
+         */
+        DerivedCache cacheCopy() const
+        {
+            std::lock_guard<std::mutex> lock(m_cacheMutex);
+            return m_cache;
+        }
+
+        /**
+         * Gets the cache, dropping its entries first if the matrix changed since they were computed.
+         * The caller holds m_cacheMutex.
+         */
+        DerivedCache& validCache() const
+        {
+            if (m_cache.version != m_version)
+            {
+                MatrixCacheStats stats = m_cache.stats;
+                m_cache = DerivedCache{};
+                m_cache.version = m_version;
+                m_cache.stats = stats;
+            }
+            return m_cache;
+        }
+
+        /**
+         * Gets the determinant, computing it if the cache has none. Like cachedLU(),
+         * it leaves the statistics to the public entry points.
+         * @param cache The cache returned by validCache().
+         */
+        T cachedDeterminant(DerivedCache& cache) const
+        {
+            if (cache.hasDeterminant)
+                return cache.determinant;
+
+            if constexpr (std::is_integral_v<T>)
+            {
+                if constexpr (std::is_same_v<T, bool>)
+                    cache.determinant = cofactorDeterminant();
+                else
+                    cache.determinant = bareissDeterminant();
+            }
+            else
+                cache.determinant = cachedLU(cache).determinant();
+            cache.hasDeterminant = true;
+            return cache.determinant;
+        }
+
+        /**
+         * Gets the LU factors, computing them if the cache has none.
+         * @param cache The cache returned by validCache().
+         */
+        const LUDecomposition<T>& cachedLU(DerivedCache& cache) const
+        {
+            if (!cache.lu)
+            {
+                Array<T> values(m_size * m_size, uninitialized);
+                T* dst = values.dataPointer();
+                for (size_t i = 0; i < m_size; ++i)
+                    for (size_t j = 0; j < m_size; ++j)
+                        dst[i * m_size + j] = storage()[offset(i, j)];
+                cache.lu = std::make_shared<const LUDecomposition<T>>(std::move(values), m_size);
+            }
+            return *cache.lu;
+        }
+
+        /**
+         * Computes the determinant by cofactor expansion along the first row.
+         */
+        T cofactorDeterminant() const
         {
             if (m_size == 1)
                 return (*this)(0, 0);
@@ -348,36 +1232,315 @@ namespace mylib {
         }
 
         /**
-         * Computes the inverse of the matrix.
-         * @return The inverse matrix.
-         * @throws "Matrix is singular" if the matrix cannot be inverted.
+         * Constructor adopting existing storage.
+         * @param size The size of the matrix.
+         * @param data The storage to share.
+         * @param transposed True if the storage holds the transpose.
          */
-        Matrix inverse() const
+        Matrix(size_t size, std::shared_ptr<Array<T>> data, bool transposed)
+            : m_size(size), m_data(std::move(data)), m_transposed(transposed) {}
+
+        /**
+         * Allocates shared storage for count elements; the control block and the
+         * elements both come from the resource when one is given.
+         */
+        static std::shared_ptr<Array<T>> makeStorage(size_t count, bool zeroed, std::pmr::memory_resource* resource)
         {
-            T det = determinant();
-            if (det == 0)
-                throw "Matrix is singular and cannot be inverted";
+            if (!resource)
+                return zeroed ? std::make_shared<Array<T>>(count) : std::make_shared<Array<T>>(count, uninitialized);
+            std::pmr::polymorphic_allocator<Array<T>> allocator(resource);
+            return zeroed ? std::allocate_shared<Array<T>>(allocator, count, resource)
+                          : std::allocate_shared<Array<T>>(allocator, count, uninitialized, resource);
+        }
 
-            Matrix adjugate = adjugateMatrix();
-            return adjugate * (static_cast<T>(1) / det);
+        /**
+         * Copies storage into a new shared block from the same resource.
+         */
+        static std::shared_ptr<Array<T>> copyStorage(const Array<T>& source)
+        {
+            std::pmr::memory_resource* resource = source.resource();
+            if (!resource)
+                return std::make_shared<Array<T>>(source);
+            return std::allocate_shared<Array<T>>(std::pmr::polymorphic_allocator<Array<T>>(resource), source, resource);
         }
 
         /**
-         * Prints the matrix to the standard output.
+         * Maps a (row, col) position to its storage offset, honoring the lazy transpose.
          */
-        void print() const
+        size_t offset(size_t row, size_t col) const
         {
-            for (size_t i = 0; i < m_size; ++i)
+            return m_transposed ? Layout::index(col, row, m_size) : Layout::index(row, col, m_size);
+        }
+
+        /**
+         * Checks whether the storage currently holds the matrix row by row.
+         */
+        bool storedRowMajor() const
+        {
+            return Layout::rowsContiguous != m_transposed;
+        }
+
+        /**
+         * Read-only access to the storage as it is, possibly transposed.
+         */
+        const T* storage() const
+        {
+            return std::as_const(*m_data).dataPointer();
+        }
+
+        /**
+         * Writable access to the storage in Layout order, for handing out mutable
+         * references: resolves a pending transpose and copies the storage if it is shared.
+         */
+        T* writableStorage()
+        {
+            ++m_version;
+            materialize();
+            if (m_data.use_count() > 1 || m_data->isReadOnly())
+                m_data = copyStorage(*m_data);
+            return m_data->dataPointer();
+        }
+
+        /**
+         * Resolves a pending lazy transpose into storage in Layout order, adopting
+         * the copy built for const readers if there is one.
+         * Other matrices sharing the old storage are unaffected.
+         */
+        void materialize()
+        {
+            if (!m_transposed)
+                return;
+            std::shared_ptr<Array<T>> canonical = m_canonical.exchange(nullptr);
+            if (!canonical)
             {
-                for (size_t j = 0; j < m_size; ++j)
-                    std::cout << m_data[i * m_size + j] << " ";
-                std::cout << "\n";
+                canonical = makeStorage(m_size * m_size, false, resource());
+                detail::blockedTranspose(storage(), canonical->dataPointer(), m_size);
             }
+            m_data = std::move(canonical);
+            m_transposed = false;
         }
 
-    private:
-        size_t m_size;          // Size of the matrix (number of rows/columns).
-        Array<T> m_data;        // Data array for storing the elements of the matrix.
+        /**
+         * Read-only access to the elements in Layout order. For a transposed matrix this
+         * is a copy built by the first caller; concurrent callers agree on one copy.
+         */
+        const Array<T>& canonicalArray() const
+        {
+            if (!m_transposed)
+                return *m_data;
+            std::shared_ptr<Array<T>> canonical = m_canonical.load(std::memory_order_acquire);
+            if (!canonical)
+            {
+                auto fresh = makeStorage(m_size * m_size, false, resource());
+                detail::blockedTranspose(storage(), fresh->dataPointer(), m_size);
+                // On failure canonical receives the copy another caller published first.
+                if (m_canonical.compare_exchange_strong(canonical, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+                    canonical = std::move(fresh);
+            }
+            return *canonical;
+        }
+
+        /**
+         * Read-only access to the storage in Layout order.
+         */
+        const T* canonicalStorage() const
+        {
+            return canonicalArray().dataPointer();
+        }
+
+        /**
+         * Applies a binary operation element by element. Operands with the same
+         * transposed state are combined directly on their storage, and the result
+         * keeps that state; otherwise both are read in Layout order.
+         * @param other The right-hand operand (same size).
+         * @param op The operation.
+         * @return The resulting matrix.
+         */
+        template <typename Op>
+        Matrix elementwise(const Matrix& other, Op op) const
+        {
+            const bool mixed = m_transposed != other.m_transposed;
+            Matrix result(m_size, uninitialized, resource());
+            const T* lhs = mixed ? canonicalStorage() : storage();
+            const T* rhs = mixed ? other.canonicalStorage() : other.storage();
+            T* out = result.m_data->dataPointer();
+            for (size_t i = 0; i < m_size * m_size; ++i)
+                out[i] = op(lhs[i], rhs[i]);
+            result.m_transposed = !mixed && m_transposed;
+            return result;
+        }
+
+        /**
+         * Converts a storage offset into a (row, column) position.
+         * @param storageOffset The storage offset.
+         * @return The position.
+         */
+        std::pair<size_t, size_t> positionOf(size_t storageOffset) const
+        {
+            if (storedRowMajor())
+                return { storageOffset / m_size, storageOffset % m_size };
+            return { storageOffset % m_size, storageOffset / m_size };
+        }
+
+        /**
+         * Largest absolute sum over the contiguous storage lines (rows in RowMajor, columns in ColMajor).
+         * @return The largest line sum, or zero for an empty matrix.
+         */
+        T maxLineAbsSum() const
+        {
+            if (m_size == 0)
+                return T(0);
+            const T* data = storage();
+            const size_t n = m_size;
+            return reduce::combine<T>(n, reduce::kParallelChunk / n + 1, [=](size_t begin, size_t end)
+            {
+                T best = simd::sumAbs(data + begin * n, n);
+                for (size_t line = begin + 1; line < end; ++line)
+                {
+                    T lineSum = simd::sumAbs(data + line * n, n);
+                    best = best < lineSum ? lineSum : best;
+                }
+                return best;
+            }, [](const T& a, const T& b) { return a < b ? b : a; });
+        }
+
+        /**
+         * Largest absolute sum across the storage lines (columns in RowMajor, rows in ColMajor).
+         * The sums are accumulated line by line so the storage is read sequentially.
+         * @return The largest cross sum, or zero for an empty matrix.
+         */
+        T maxCrossAbsSum() const
+        {
+            if (m_size == 0)
+                return T(0);
+            const T* data = storage();
+            const size_t n = m_size;
+            Array<T> sums = reduce::combine<Array<T>>(n, reduce::kParallelChunk / n + 1, [=](size_t begin, size_t end)
+            {
+                Array<T> partial(n);
+                T* acc = partial.dataPointer();
+                for (size_t line = begin; line < end; ++line)
+                {
+                    const T* src = data + line * n;
+                    for (size_t j = 0; j < n; ++j)
+                        acc[j] += simd::absValue(src[j]);
+                }
+                return partial;
+            }, [n](const Array<T>& a, const Array<T>& b)
+            {
+                Array<T> merged(a);
+                T* acc = merged.dataPointer();
+                const T* other = b.dataPointer();
+                for (size_t j = 0; j < n; ++j)
+                    acc[j] += other[j];
+                return merged;
+            });
+            return simd::maxValue(sums.dataPointer(), n);
+        }
+
+        /**
+         * Distance in the storage between two consecutive elements of a column.
+         * @return The column stride.
+         */
+        size_t columnStride() const
+        {
+            return Layout::rowsContiguous ? m_size : 1;
+        }
+
+        /**
+         * Computes the determinant of an integral matrix exactly with Bareiss
+         * fraction-free elimination in O(n^3). The elimination runs in 64-bit
+         * arithmetic and is retried in 128-bit arithmetic when a step overflows.
+         * @return The determinant.
+         * @throws "Determinant overflow" if the result or an intermediate minor does not fit.
+         */
+        T bareissDeterminant() const
+        {
+            if (m_size == 0)
+                return static_cast<T>(1);
+
+            long long det64;
+            if (bareissElimination(det64))
+            {
+                if (!detail::fitsIn<T>(det64))
+                    throw "Determinant overflow";
+                return static_cast<T>(det64);
+            }
+#ifdef __SIZEOF_INT128__
+            detail::int128 det128;
+            if (bareissElimination(det128))
+            {
+                if (!detail::fitsIn<T>(det128))
+                    throw "Determinant overflow";
+                return static_cast<T>(det128);
+            }
+#endif
+            throw "Determinant overflow";
+        }
+
+        /**
+         * Runs Bareiss elimination on a copy of the matrix widened to W.
+         * Every division in the recurrence is exact, so no rounding occurs.
+         * The storage is read as row-major whatever the layout: a ColMajor
+         * buffer is the transpose, which has the same determinant.
+         * @param det Receives the determinant on success.
+         * @return False if a value overflowed W.
+         */
+        template <typename W>
+        bool bareissElimination(W& det) const
+        {
+            const size_t n = m_size;
+            const T* source = storage();
+            Array<W> work(n * n);
+            W* a = work.dataPointer();
+            for (size_t i = 0; i < n * n; ++i)
+            {
+                if (!detail::fitsIn<W>(source[i]))
+                    return false;
+                a[i] = static_cast<W>(source[i]);
+            }
+
+            bool negate = false;
+            W previousPivot = 1;
+            for (size_t k = 0; k + 1 < n; ++k)
+            {
+                if (a[k * n + k] == 0)
+                {
+                    size_t swapRow = k + 1;
+                    while (swapRow < n && a[swapRow * n + k] == 0)
+                        ++swapRow;
+                    if (swapRow == n)
+                    {
+                        det = 0;
+                        return true;
+                    }
+                    for (size_t j = k; j < n; ++j)
+                        std::swap(a[k * n + j], a[swapRow * n + j]);
+                    negate = !negate;
+                }
+
+                const W pivot = a[k * n + k];
+                const W* pivotRow = a + k * n;
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    W* row = a + i * n;
+                    const W lead = row[k];
+                    for (size_t j = k + 1; j < n; ++j)
+                    {
+                        W value;
+                        if (detail::mulSubOverflows(row[j], pivot, lead, pivotRow[j], value))
+                            return false;
+                        row[j] = value / previousPivot;
+                    }
+                }
+                previousPivot = pivot;
+            }
+
+            det = a[n * n - 1];
+            if (negate)
+                return !detail::mulSubOverflows(a[n * n - 1], W(-1), W(0), W(0), det);
+            return true;
+        }
 
         /**
          * Calculates the cofactor matrix.
@@ -443,6 +1606,157 @@ namespace mylib {
             return result.transpose();
         }
     };
+
+    namespace detail
+    {
+        /// Output elements below which the parallel Matrix kernels stay on one thread.
+        constexpr size_t kParallelMatrixChunk = size_t(1) << 16;
+
+        /**
+         * Writes rows [rowBegin, rowEnd) of the Kronecker product of a (n x n) and b (m x m).
+         * Each output row is n contiguous blocks, each a copy of one row of b scaled by an element of a.
+         * Since kron(A, B)^T = kron(A^T, B^T), the same loop on ColMajor storage yields ColMajor output.
+         */
+        template <typename T>
+        void kronRows(const T* a, size_t n, const T* b, size_t m, T* out, size_t rowBegin, size_t rowEnd)
+        {
+            const size_t outSize = n * m;
+            for (size_t row = rowBegin; row < rowEnd; ++row)
+            {
+                const T* aRow = a + (row / m) * n;
+                const T* bRow = b + (row % m) * m;
+                T* dst = out + row * outSize;
+                for (size_t j = 0; j < n; ++j, dst += m)
+                {
+                    const T scale = aRow[j];
+                    for (size_t l = 0; l < m; ++l)
+                        dst[l] = scale * bRow[l];
+                }
+            }
+        }
+    }
+
+    /**
+     * Computes the elementwise (Hadamard) product of two matrices.
+     * @param a The first matrix.
+     * @param b The second matrix.
+     * @return A new matrix with result(i, j) = a(i, j) * b(i, j).
+     * @throws "Matrix sizes do not match" if the matrices have different sizes.
+     */
+    template <typename T, typename Layout>
+    Matrix<T, Layout> hadamard(const Matrix<T, Layout>& a, const Matrix<T, Layout>& b)
+    {
+        if (a.size() != b.size())
+            throw "Matrix sizes do not match";
+        Matrix<T, Layout> result(a.size(), uninitialized, a.resource());
+        const T* lhs = a.getBegin();
+        const T* rhs = b.getBegin();
+        T* out = result.begin();
+        const size_t count = a.size() * a.size();
+        for (size_t i = 0; i < count; ++i)
+            out[i] = lhs[i] * rhs[i];
+        return result;
+    }
+
+    /**
+     * Multiplies a matrix elementwise by another matrix in place (a = a o b).
+     * @param a The matrix to update.
+     * @param b The matrix to multiply by.
+     * @throws "Matrix sizes do not match" if the matrices have different sizes.
+     */
+    template <typename T, typename Layout>
+    void hadamardInPlace(Matrix<T, Layout>& a, const Matrix<T, Layout>& b)
+    {
+        if (a.size() != b.size())
+            throw "Matrix sizes do not match";
+        T* lhs = a.begin();
+        const T* rhs = b.getBegin();
+        const size_t count = a.size() * a.size();
+        for (size_t i = 0; i < count; ++i)
+            lhs[i] *= rhs[i];
+    }
+
+    /**
+     * Computes the Kronecker product of two matrices.
+     * @param a The first matrix (n x n).
+     * @param b The second matrix (m x m).
+     * @return A new (n * m) x (n * m) matrix made of the blocks a(i, j) * b.
+     */
+    template <typename T, typename Layout>
+    Matrix<T, Layout> kron(const Matrix<T, Layout>& a, const Matrix<T, Layout>& b)
+    {
+        Matrix<T, Layout> result(a.size() * b.size(), uninitialized, a.resource());
+        detail::kronRows(a.getBegin(), a.size(), b.getBegin(), b.size(), result.begin(), 0, result.size());
+        return result;
+    }
+
+    /**
+     * Multithreaded variant of hadamard() for large matrices.
+     * @param a The first matrix.
+     * @param b The second matrix.
+     * @return A new matrix with result(i, j) = a(i, j) * b(i, j).
+     * @throws "Matrix sizes do not match" if the matrices have different sizes.
+     */
+    template <typename T, typename Layout>
+    Matrix<T, Layout> parallelHadamard(const Matrix<T, Layout>& a, const Matrix<T, Layout>& b)
+    {
+        if (a.size() != b.size())
+            throw "Matrix sizes do not match";
+        Matrix<T, Layout> result(a.size(), uninitialized, a.resource());
+        const T* lhs = a.getBegin();
+        const T* rhs = b.getBegin();
+        T* out = result.begin();
+        parallel::forRange(a.size() * a.size(), detail::kParallelMatrixChunk, [=](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                out[i] = lhs[i] * rhs[i];
+        });
+        return result;
+    }
+
+    /**
+     * Multithreaded variant of hadamardInPlace() for large matrices.
+     * @param a The matrix to update.
+     * @param b The matrix to multiply by.
+     * @throws "Matrix sizes do not match" if the matrices have different sizes.
+     */
+    template <typename T, typename Layout>
+    void parallelHadamardInPlace(Matrix<T, Layout>& a, const Matrix<T, Layout>& b)
+    {
+        if (a.size() != b.size())
+            throw "Matrix sizes do not match";
+        T* lhs = a.begin();
+        const T* rhs = b.getBegin();
+        parallel::forRange(a.size() * a.size(), detail::kParallelMatrixChunk, [=](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                lhs[i] *= rhs[i];
+        });
+    }
+
+    /**
+     * Multithreaded variant of kron() for large outputs; output rows are split across workers.
+     * @param a The first matrix (n x n).
+     * @param b The second matrix (m x m).
+     * @return A new (n * m) x (n * m) matrix made of the blocks a(i, j) * b.
+     */
+    template <typename T, typename Layout>
+    Matrix<T, Layout> parallelKron(const Matrix<T, Layout>& a, const Matrix<T, Layout>& b)
+    {
+        Matrix<T, Layout> result(a.size() * b.size(), uninitialized, a.resource());
+        const size_t outSize = result.size();
+        const size_t minRows = outSize == 0 ? 1 : detail::kParallelMatrixChunk / outSize + 1;
+        const T* lhs = a.getBegin();
+        const T* rhs = b.getBegin();
+        T* out = result.begin();
+        const size_t n = a.size();
+        const size_t m = b.size();
+        parallel::forRange(outSize, minRows, [=](size_t begin, size_t end)
+        {
+            detail::kronRows(lhs, n, rhs, m, out, begin, end);
+        });
+        return result;
+    }
 }
 
 #endif // MYLIB_MATRIX_H
\ No newline at end of file
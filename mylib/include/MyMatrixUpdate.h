@@ -0,0 +1,317 @@
+#ifndef MYLIB_MATRIX_UPDATE_H
+#define MYLIB_MATRIX_UPDATE_H
+
+#include <cmath>
+
+#include "MyArray.h"
+#include "MyMatrix.h"
+
+namespace mylib
+{
+    /*
+        Low-rank updates of inverses and factorizations. Each one turns the
+        factorization or inverse of A into that of A plus a rank-k term in
+        O(k n^2) instead of refactoring from scratch in O(n^3).
+    */
+
+    /**
+     * Updates an inverse for a rank-1 change (Sherman-Morrison):
+     * given inverse = A^-1, makes it (A + u v^T)^-1.
+     * @param inverse The inverse of A, updated in place.
+     * @param u The column vector of the update.
+     * @param v The row vector of the update.
+     * @throws "Dimension mismatch" if u or v does not match the matrix size.
+     * @throws "Update makes the matrix singular" if A + u v^T is singular.
+     */
+    template <typename T, typename Layout>
+    void shermanMorrisonUpdate(Matrix<T, Layout>& inverse, const Array<T>& u, const Array<T>& v)
+    {
+        const size_t n = inverse.size();
+        if (u.getSize() != n || v.getSize() != n)
+            throw "Dimension mismatch";
+
+        T* b = inverse.begin();
+        auto at = [&](size_t i, size_t j) -> T& { return b[Layout::index(i, j, n)]; };
+        const T* uData = u.dataPointer();
+        const T* vData = v.dataPointer();
+
+        // x = B u, y = B^T v.
+        Array<T> x(n), y(n);
+        T* xData = x.dataPointer();
+        T* yData = y.dataPointer();
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+            {
+                xData[i] += at(i, j) * uData[j];
+                yData[j] += vData[i] * at(i, j);
+            }
+
+        T denominator = T(1);
+        for (size_t i = 0; i < n; ++i)
+            denominator += vData[i] * xData[i];
+        if (denominator == T(0))
+            throw "Update makes the matrix singular";
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const T scale = xData[i] / denominator;
+            for (size_t j = 0; j < n; ++j)
+                at(i, j) -= scale * yData[j];
+        }
+    }
+
+    /**
+     * Updates an inverse after one row of A changes by delta (row becomes row + delta).
+     * @param inverse The inverse of A, updated in place.
+     * @param row The index of the changed row.
+     * @param delta The change applied to the row.
+     * @throws "Index out of range" if row is out of bounds.
+     */
+    template <typename T, typename Layout>
+    void updateInverseRow(Matrix<T, Layout>& inverse, size_t row, const Array<T>& delta)
+    {
+        if (row >= inverse.size())
+            throw "Index out of range";
+        Array<T> unit(inverse.size());
+        unit[row] = T(1);
+        shermanMorrisonUpdate(inverse, unit, delta);
+    }
+
+    /**
+     * Updates an inverse after one column of A changes by delta (column becomes column + delta).
+     * @param inverse The inverse of A, updated in place.
+     * @param col The index of the changed column.
+     * @param delta The change applied to the column.
+     * @throws "Index out of range" if col is out of bounds.
+     */
+    template <typename T, typename Layout>
+    void updateInverseColumn(Matrix<T, Layout>& inverse, size_t col, const Array<T>& delta)
+    {
+        if (col >= inverse.size())
+            throw "Index out of range";
+        Array<T> unit(inverse.size());
+        unit[col] = T(1);
+        shermanMorrisonUpdate(inverse, delta, unit);
+    }
+
+    /**
+     * Updates an inverse for a rank-k change (Woodbury):
+     * given inverse = A^-1, makes it (A + U V^T)^-1, where U and V are n x k.
+     * Only a k x k system is inverted.
+     * @param inverse The inverse of A, updated in place.
+     * @param uColumns The k columns of U.
+     * @param vColumns The k columns of V.
+     * @throws "Dimension mismatch" if the columns do not match the matrix size or each other.
+     * @throws "Matrix is singular and cannot be inverted" if A + U V^T is singular.
+     */
+    template <typename T, typename Layout>
+    void woodburyUpdate(Matrix<T, Layout>& inverse, const Array<Array<T>>& uColumns, const Array<Array<T>>& vColumns)
+    {
+        const size_t n = inverse.size();
+        const size_t k = uColumns.getSize();
+        if (vColumns.getSize() != k)
+            throw "Dimension mismatch";
+        for (size_t c = 0; c < k; ++c)
+            if (uColumns[c].getSize() != n || vColumns[c].getSize() != n)
+                throw "Dimension mismatch";
+        if (k == 0)
+            return;
+
+        T* b = inverse.begin();
+        auto at = [&](size_t i, size_t j) -> T& { return b[Layout::index(i, j, n)]; };
+
+        // X = B U (n x k, stored by column), Y = V^T B (k x n, stored by row).
+        Array<T> x(n * k), y(k * n);
+        T* xData = x.dataPointer();
+        T* yData = y.dataPointer();
+        for (size_t c = 0; c < k; ++c)
+        {
+            const T* u = uColumns[c].dataPointer();
+            const T* v = vColumns[c].dataPointer();
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                {
+                    xData[c * n + i] += at(i, j) * u[j];
+                    yData[c * n + j] += v[i] * at(i, j);
+                }
+        }
+
+        // Capacitance matrix C = I + V^T B U (k x k).
+        Matrix<T> capacitance(k);
+        for (size_t a = 0; a < k; ++a)
+        {
+            const T* v = vColumns[a].dataPointer();
+            for (size_t c = 0; c < k; ++c)
+            {
+                T value = a == c ? T(1) : T(0);
+                for (size_t i = 0; i < n; ++i)
+                    value += v[i] * xData[c * n + i];
+                capacitance(a, c) = value;
+            }
+        }
+        const Matrix<T> capacitanceInverse = capacitance.inverse();
+
+        // B -= X (C^-1 Y).
+        Array<T> w(k * n);
+        T* wData = w.dataPointer();
+        for (size_t a = 0; a < k; ++a)
+            for (size_t c = 0; c < k; ++c)
+            {
+                const T scale = capacitanceInverse(a, c);
+                for (size_t j = 0; j < n; ++j)
+                    wData[a * n + j] += scale * yData[c * n + j];
+            }
+        for (size_t i = 0; i < n; ++i)
+            for (size_t a = 0; a < k; ++a)
+            {
+                const T scale = xData[a * n + i];
+                for (size_t j = 0; j < n; ++j)
+                    at(i, j) -= scale * wData[a * n + j];
+            }
+    }
+
+    /**
+     * Computes the Cholesky factor of a symmetric positive-definite matrix.
+     * @param matrix The matrix A.
+     * @return The lower-triangular L with A = L L^T.
+     * @throws "Matrix is not positive definite" if the factorization breaks down.
+     */
+    template <typename T, typename Layout>
+    Matrix<T, Layout> cholesky(const Matrix<T, Layout>& matrix)
+    {
+        const size_t n = matrix.size();
+        Matrix<T, Layout> result(n);
+        T* l = result.begin();
+        auto at = [&](size_t i, size_t j) -> T& { return l[Layout::index(i, j, n)]; };
+        for (size_t j = 0; j < n; ++j)
+        {
+            T diagonal = matrix(j, j);
+            for (size_t k = 0; k < j; ++k)
+                diagonal -= at(j, k) * at(j, k);
+            if (!(diagonal > T(0)))
+                throw "Matrix is not positive definite";
+            const T pivot = std::sqrt(diagonal);
+            at(j, j) = pivot;
+            for (size_t i = j + 1; i < n; ++i)
+            {
+                T value = matrix(i, j);
+                for (size_t k = 0; k < j; ++k)
+                    value -= at(i, k) * at(j, k);
+                at(i, j) = value / pivot;
+            }
+        }
+        return result;
+    }
+
+    namespace detail
+    {
+        /**
+         * Shared rank-1 update (sign = 1) / downdate (sign = -1) of a Cholesky factor.
+         */
+        template <typename T, typename Layout>
+        void choleskyRankOne(Matrix<T, Layout>& factor, const Array<T>& vector, T sign)
+        {
+            const size_t n = factor.size();
+            if (vector.getSize() != n)
+                throw "Dimension mismatch";
+            Array<T> work(vector);
+            T* x = work.dataPointer();
+            T* l = factor.begin();
+            auto at = [&](size_t i, size_t j) -> T& { return l[Layout::index(i, j, n)]; };
+            for (size_t k = 0; k < n; ++k)
+            {
+                const T diagonal = at(k, k);
+                const T squared = diagonal * diagonal + sign * x[k] * x[k];
+                if (!(squared > T(0)))
+                    throw "Downdate makes the matrix indefinite";
+                const T r = std::sqrt(squared);
+                const T c = r / diagonal;
+                const T s = x[k] / diagonal;
+                at(k, k) = r;
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    at(i, k) = (at(i, k) + sign * s * x[i]) / c;
+                    x[i] = c * x[i] - s * at(i, k);
+                }
+            }
+        }
+    }
+
+    /**
+     * Updates a Cholesky factor for A + x x^T in O(n^2).
+     * @param factor The lower-triangular factor L of A, updated in place.
+     * @param x The update vector.
+     * @throws "Dimension mismatch" if x does not match the factor size.
+     */
+    template <typename T, typename Layout>
+    void choleskyUpdate(Matrix<T, Layout>& factor, const Array<T>& x)
+    {
+        detail::choleskyRankOne(factor, x, T(1));
+    }
+
+    /**
+     * Downdates a Cholesky factor for A - x x^T in O(n^2).
+     * @param factor The lower-triangular factor L of A, updated in place.
+     * @param x The downdate vector.
+     * @throws "Dimension mismatch" if x does not match the factor size.
+     * @throws "Downdate makes the matrix indefinite" if A - x x^T is not positive definite.
+     */
+    template <typename T, typename Layout>
+    void choleskyDowndate(Matrix<T, Layout>& factor, const Array<T>& x)
+    {
+        detail::choleskyRankOne(factor, x, T(-1));
+    }
+
+    /**
+     * Updates LU factors for A + x y^T in O(n^2) (Bennett's algorithm).
+     * The row permutation is kept as is, so the update does not re-pivot;
+     * refactor if the pivots become small.
+     * Pass -x for a downdate.
+     * @param factors The factorization P A = L U, updated in place.
+     * @param x The column vector of the update.
+     * @param y The row vector of the update.
+     * @throws "Dimension mismatch" if x or y does not match the factorization size.
+     * @throws "Matrix is singular" if the factorization or the updated matrix has a zero pivot.
+     */
+    template <typename T>
+    void luUpdate(LUDecomposition<T>& factors, const Array<T>& x, const Array<T>& y)
+    {
+        const size_t n = factors.size;
+        if (x.getSize() != n || y.getSize() != n)
+            throw "Dimension mismatch";
+        if (factors.singular)
+            throw "Matrix is singular";
+
+        Array<T> wWork(n), zWork(y);
+        T* w = wWork.dataPointer();
+        T* z = zWork.dataPointer();
+        const size_t* perm = factors.permutation.dataPointer();
+        for (size_t i = 0; i < n; ++i)
+            w[i] = x[perm[i]];
+
+        T* a = factors.factors.dataPointer();
+        for (size_t k = 0; k < n; ++k)
+        {
+            T* uRow = a + k * n;
+            const T oldPivot = uRow[k];
+            const T pivot = oldPivot + w[k] * z[k];
+            if (pivot == T(0))
+                throw "Matrix is singular";
+            uRow[k] = pivot;
+            for (size_t j = k + 1; j < n; ++j)
+            {
+                uRow[j] += w[k] * z[j];
+                z[j] -= z[k] * uRow[j] / pivot;
+            }
+            for (size_t i = k + 1; i < n; ++i)
+            {
+                T& lower = a[i * n + k];
+                const T oldLower = lower;
+                lower = (oldLower * oldPivot + w[i] * z[k]) / pivot;
+                w[i] -= w[k] * oldLower;
+            }
+        }
+    }
+} // namespace mylib
+
+#endif // MYLIB_MATRIX_UPDATE_H
@@ -0,0 +1,459 @@
+#ifndef MYLIB_MEMORY_H
+#define MYLIB_MEMORY_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MYLIB_HAS_MMAP 1
+#else
+#define MYLIB_HAS_MMAP 0
+#endif
+
+#if defined(__linux__)
+#define MYLIB_HAS_HUGE_PAGES 1
+#else
+#define MYLIB_HAS_HUGE_PAGES 0
+#endif
+
+namespace mylib
+{
+    /**
+     * Allocation helpers shared by the containers. Every container takes an optional
+     * std::pmr::memory_resource; a null resource means the global heap, which keeps
+     * the containers' own fast paths (e.g. calloc/realloc in Array). Moves and swaps
+     * carry the resource along with the storage it allocated; copies allocate from
+     * the resource of the container being constructed or assigned to.
+     */
+    namespace memory
+    {
+        /**
+         * Allocates raw memory from a resource, or from the global heap if resource is null.
+         * @param resource The memory resource, or nullptr.
+         * @param bytes The number of bytes.
+         * @param alignment The required alignment.
+         * @return The allocated memory.
+         * @throws std::bad_alloc if the allocation fails.
+         */
+        inline void* allocate(std::pmr::memory_resource* resource, size_t bytes, size_t alignment)
+        {
+            if (resource)
+                return resource->allocate(bytes, alignment);
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+
+        /**
+         * Returns memory obtained from allocate() with the same resource, size and alignment.
+         */
+        inline void deallocate(std::pmr::memory_resource* resource, void* memory, size_t bytes, size_t alignment)
+        {
+            if (resource)
+                resource->deallocate(memory, bytes, alignment);
+            else
+                ::operator delete(memory, std::align_val_t(alignment));
+        }
+
+        /**
+         * Allocates uninitialized storage for count objects of type T.
+         * @param resource The memory resource, or nullptr for the global heap.
+         * @param count The number of objects (0 yields nullptr).
+         * @return The storage.
+         * @throws std::bad_alloc if the allocation fails or the size overflows.
+         */
+        template <typename T>
+        T* allocateArray(std::pmr::memory_resource* resource, size_t count)
+        {
+            if (count == 0)
+                return nullptr;
+            if (count > static_cast<size_t>(-1) / sizeof(T))
+                throw std::bad_alloc();
+            return static_cast<T*>(allocate(resource, count * sizeof(T), alignof(T)));
+        }
+
+        /**
+         * Releases storage obtained from allocateArray() (the objects must already be destroyed).
+         */
+        template <typename T>
+        void deallocateArray(std::pmr::memory_resource* resource, T* data, size_t count)
+        {
+            if (data)
+                deallocate(resource, data, count * sizeof(T), alignof(T));
+        }
+
+        /**
+         * Allocates and constructs a single object.
+         * @param resource The memory resource, or nullptr for the global heap.
+         * @param args The constructor arguments.
+         * @return The new object.
+         */
+        template <typename T, typename... Args>
+        T* create(std::pmr::memory_resource* resource, Args&&... args)
+        {
+            void* memory = allocate(resource, sizeof(T), alignof(T));
+            try
+            {
+                return ::new (memory) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                deallocate(resource, memory, sizeof(T), alignof(T));
+                throw;
+            }
+        }
+
+        /**
+         * Destroys and releases an object obtained from create() with the same resource.
+         */
+        template <typename T>
+        void destroy(std::pmr::memory_resource* resource, T* object)
+        {
+            if (!object)
+                return;
+            object->~T();
+            deallocate(resource, object, sizeof(T), alignof(T));
+        }
+
+        /**
+         * Marks types whose objects can be moved to new storage with memcpy, the old bytes
+         * then being dropped without running the destructor. True for trivially copyable
+         * types; containers that own their storage only through a pointer specialize it.
+         */
+        template <typename T>
+        struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+        template <typename T>
+        inline constexpr bool kTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+        /**
+         * Moves count objects into uninitialized storage and ends their lifetime at the source.
+         * Trivially relocatable types are copied bytewise; otherwise elements are moved if the
+         * move cannot throw (or there is no copy), else copied so a throw leaves the source intact.
+         * @param source The objects to relocate.
+         * @param count The number of objects.
+         * @param destination Uninitialized storage for count objects, not overlapping the source.
+         */
+        template <typename T>
+        void relocate(T* source, size_t count, T* destination)
+        {
+            if constexpr (kTriviallyRelocatable<T>)
+            {
+                if (count)
+                    std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+            }
+            else
+            {
+                if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                    std::uninitialized_move_n(source, count, destination);
+                else
+                    std::uninitialized_copy_n(source, count, destination);
+                std::destroy_n(source, count);
+            }
+        }
+
+        /**
+         * How a buffer's pages are backed.
+         */
+        enum class PageBacking : unsigned char
+        {
+            Heap,             ///< Regular heap or memory-resource allocation.
+            Mapped,           ///< Anonymous mapping whose huge-page advice was rejected.
+            TransparentHuge,  ///< 2 MB-aligned mapping tagged with MADV_HUGEPAGE.
+            HugeTlb,          ///< Mapping from the reserved MAP_HUGETLB pool.
+            FileReadOnly,     ///< Read-only mapping of a file.
+            FileCopyOnWrite   ///< Private writable mapping of a file; writes never reach the file.
+        };
+
+        /**
+         * Access mode of a file mapping.
+         */
+        enum class FileMapping
+        {
+            ReadOnly,     ///< Pages are shared with the page cache; writing to them faults.
+            CopyOnWrite   ///< Pages are shared until written, then privately copied.
+        };
+
+        /**
+         * Counts of large buffers by the backing they ended up with, since the last reset.
+         */
+        struct HugePageStats
+        {
+            size_t hugeTlbBuffers;      ///< Buffers backed by MAP_HUGETLB pages.
+            size_t transparentBuffers;  ///< Buffers tagged for transparent huge pages.
+            size_t fallbackBuffers;     ///< Buffers above the threshold that got regular pages.
+            size_t hugeBytes;           ///< Bytes mapped in the first two categories.
+        };
+
+        /// Size of the huge pages requested (x86-64 and AArch64 default). MAP_HUGETLB asks for
+        /// this size explicitly rather than the system default, which may be 1 GB, so every
+        /// mapping length (mmap, munmap, mremap) is a multiple of it.
+        constexpr size_t kHugePageSize = size_t(2) << 20;
+
+        /// Default buffer size from which huge pages are requested.
+        constexpr size_t kDefaultHugePageThreshold = size_t(4) << 20;
+
+        namespace detail
+        {
+            struct HugePageState
+            {
+                std::atomic<size_t> threshold{ kDefaultHugePageThreshold };
+                std::atomic<size_t> hugeTlb{ 0 };
+                std::atomic<size_t> transparent{ 0 };
+                std::atomic<size_t> fallback{ 0 };
+                std::atomic<size_t> hugeBytes{ 0 };
+            };
+
+            inline HugePageState& hugePageState()
+            {
+                static HugePageState instance;
+                return instance;
+            }
+
+            inline size_t hugeMappingLength(size_t bytes)
+            {
+                return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+            }
+
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+            /// mmap flags selecting kHugePageSize pages from the hugetlb pool (MAP_HUGE_2MB).
+            constexpr int kHugeTlbFlags = MAP_HUGETLB | (std::countr_zero(kHugePageSize) << MAP_HUGE_SHIFT);
+#endif
+        }
+
+        /**
+         * Sets the buffer size from which huge pages are requested.
+         * @param bytes The threshold in bytes; 0 disables huge pages.
+         */
+        inline void setHugePageThreshold(size_t bytes)
+        {
+            detail::hugePageState().threshold = bytes;
+        }
+
+        /**
+         * Gets the buffer size from which huge pages are requested (0 if disabled).
+         */
+        inline size_t hugePageThreshold()
+        {
+            return detail::hugePageState().threshold;
+        }
+
+        /**
+         * Checks whether a buffer of the given size should be backed by huge pages.
+         */
+        inline bool wantsHugePages(size_t bytes)
+        {
+            const size_t threshold = hugePageThreshold();
+            return MYLIB_HAS_HUGE_PAGES && threshold != 0 && bytes >= threshold;
+        }
+
+        /**
+         * Gets the huge-page statistics.
+         */
+        inline HugePageStats hugePageStats()
+        {
+            detail::HugePageState& s = detail::hugePageState();
+            return HugePageStats{ s.hugeTlb, s.transparent, s.fallback, s.hugeBytes };
+        }
+
+        /**
+         * Resets the huge-page statistics.
+         */
+        inline void resetHugePageStats()
+        {
+            detail::HugePageState& s = detail::hugePageState();
+            s.hugeTlb = 0;
+            s.transparent = 0;
+            s.fallback = 0;
+            s.hugeBytes = 0;
+        }
+
+        /**
+         * Maps zeroed memory for a large buffer, preferring 2 MB pages from the MAP_HUGETLB
+         * pool and otherwise a 2 MB-aligned mapping advised with MADV_HUGEPAGE.
+         * @param bytes The buffer size.
+         * @param backing Receives the backing that was obtained.
+         * @return The memory, or nullptr if nothing could be mapped (use the heap instead).
+         */
+        inline void* mapHugePages(size_t bytes, PageBacking& backing)
+        {
+            detail::HugePageState& s = detail::hugePageState();
+#if MYLIB_HAS_HUGE_PAGES
+            const size_t length = detail::hugeMappingLength(bytes);
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+            void* huge = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | detail::kHugeTlbFlags, -1, 0);
+            if (huge != MAP_FAILED)
+            {
+                backing = PageBacking::HugeTlb;
+                ++s.hugeTlb;
+                s.hugeBytes += length;
+                return huge;
+            }
+#endif
+            // Over-map by one huge page and trim, so the buffer starts on a 2 MB boundary.
+            void* raw = ::mmap(nullptr, length + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw != MAP_FAILED)
+            {
+                const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+                const uintptr_t aligned = (start + kHugePageSize - 1) & ~(uintptr_t(kHugePageSize) - 1);
+                if (aligned > start)
+                    ::munmap(raw, aligned - start);
+                const size_t tail = (start + length + kHugePageSize) - (aligned + length);
+                if (tail)
+                    ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+                void* memory = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+                if (::madvise(memory, length, MADV_HUGEPAGE) == 0)
+                {
+                    backing = PageBacking::TransparentHuge;
+                    ++s.transparent;
+                    s.hugeBytes += length;
+                    return memory;
+                }
+#endif
+                backing = PageBacking::Mapped;
+                ++s.fallback;
+                return memory;
+            }
+#else
+            (void)bytes;
+#endif
+            backing = PageBacking::Heap;
+            ++s.fallback;
+            return nullptr;
+        }
+
+        /**
+         * Unmaps memory obtained from mapHugePages() for a buffer of the given size.
+         */
+        inline void unmapHugePages(void* memory, size_t bytes)
+        {
+#if MYLIB_HAS_HUGE_PAGES
+            if (memory)
+                ::munmap(memory, detail::hugeMappingLength(bytes));
+#else
+            (void)memory;
+            (void)bytes;
+#endif
+        }
+
+        /**
+         * Resizes memory obtained from mapHugePages(), letting the kernel move the page mappings
+         * instead of copying the contents. Pages added at the end are zeroed.
+         * @param memory The mapping.
+         * @param oldBytes The size the mapping was created or last remapped for.
+         * @param newBytes The new size.
+         * @return The possibly moved mapping, or nullptr if it could not be resized (it is then left intact).
+         */
+        inline void* remapHugePages(void* memory, size_t oldBytes, size_t newBytes)
+        {
+#if MYLIB_HAS_HUGE_PAGES && defined(MREMAP_MAYMOVE)
+            const size_t oldLength = detail::hugeMappingLength(oldBytes);
+            const size_t newLength = detail::hugeMappingLength(newBytes);
+            if (oldLength == newLength)
+                return memory;
+            void* moved = ::mremap(memory, oldLength, newLength, MREMAP_MAYMOVE);
+            return moved == MAP_FAILED ? nullptr : moved;
+#else
+            (void)memory;
+            (void)oldBytes;
+            (void)newBytes;
+            return nullptr;
+#endif
+        }
+
+        /**
+         * Returns the physical pages of the whole pages inside a range to the system while the
+         * range stays allocated (they read back as zeros). Used to free a large buffer gradually
+         * so its final release does not have to unmap every page at once. Partial pages at
+         * either end, and therefore any allocator metadata next to the range, are left alone.
+         * @param memory The start of the range, whose contents are no longer needed.
+         * @param bytes The size of the range.
+         */
+        inline void discardPages(void* memory, size_t bytes)
+        {
+#if MYLIB_HAS_MMAP && defined(MADV_DONTNEED)
+            static const uintptr_t pageSize = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+            const uintptr_t begin = (reinterpret_cast<uintptr_t>(memory) + pageSize - 1) & ~(pageSize - 1);
+            const uintptr_t end = (reinterpret_cast<uintptr_t>(memory) + bytes) & ~(pageSize - 1);
+            if (end > begin)
+                ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+#else
+            (void)memory;
+            (void)bytes;
+#endif
+        }
+
+        /**
+         * Maps the whole elements of a binary file into memory. Pages are read on first access.
+         * @param path The file to map.
+         * @param mode Read-only or copy-on-write access.
+         * @param elementSize The size of one element; a trailing partial element is not mapped.
+         * @param count Receives the number of elements mapped.
+         * @return The mapping, or nullptr if the file holds no whole element.
+         * @throws "Cannot map file" if the file cannot be opened or mapped.
+         */
+        inline void* mapFile(const std::string& path, FileMapping mode, size_t elementSize, size_t& count)
+        {
+            count = 0;
+#if MYLIB_HAS_MMAP
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw "Cannot map file";
+            struct stat info;
+            if (::fstat(fd, &info) != 0)
+            {
+                ::close(fd);
+                throw "Cannot map file";
+            }
+            const size_t elements = static_cast<size_t>(info.st_size) / elementSize;
+            if (elements == 0)
+            {
+                ::close(fd);
+                return nullptr;
+            }
+            const int protection = mode == FileMapping::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+            void* mapped = ::mmap(nullptr, elements * elementSize, protection, MAP_PRIVATE, fd, 0);
+            ::close(fd);  // The mapping keeps the file referenced.
+            if (mapped == MAP_FAILED)
+                throw "Cannot map file";
+            count = elements;
+            return mapped;
+#else
+            (void)path;
+            (void)mode;
+            (void)elementSize;
+            throw "Cannot map file";
+#endif
+        }
+
+        /**
+         * Unmaps memory obtained from mapFile().
+         * @param memory The mapping.
+         * @param bytes The mapped size (element count times element size).
+         */
+        inline void unmapFile(void* memory, size_t bytes)
+        {
+#if MYLIB_HAS_MMAP
+            if (memory)
+                ::munmap(memory, bytes);
+#else
+            (void)memory;
+            (void)bytes;
+#endif
+        }
+    } // namespace memory
+} // namespace mylib
+
+#endif // MYLIB_MEMORY_H
@@ -1,7 +1,13 @@
 #ifndef MYLIB_VECTOR_ND_H
 #define MYLIB_VECTOR_ND_H
 
+#include <cmath>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
 #include "MyArray.h"
+#include "MyReduce.h"
 
 namespace mylib
 {
@@ -30,6 +36,34 @@ namespace mylib
                 m_data[i++] = val;
         }
 
+        /**
+         * Constructor adopting existing storage, e.g. a file-backed Array.
+         * @param data The elements of the vector.
+         */
+        explicit VectorND(Array<T>&& data) : m_data(std::move(data)) {}
+
+        /**
+         * Creates a vector backed by a memory-mapped binary file of raw elements.
+         * @param path The file to map.
+         * @param mode ReadOnly or CopyOnWrite (see Array::mapFile()).
+         * @return The vector.
+         * @throws "Cannot map file" if the file cannot be opened or mapped.
+         */
+        static VectorND mapFile(const std::string& path, memory::FileMapping mode = memory::FileMapping::ReadOnly)
+        {
+            return VectorND(Array<T>::mapFile(path, mode));
+        }
+
+        /**
+         * Writes the raw elements to a binary file that mapFile() can load.
+         * @param path The file to write.
+         * @throws "Cannot write file" if the file cannot be written.
+         */
+        void writeToFile(const std::string& path) const
+        {
+            m_data.writeToFile(path);
+        }
+
         /**
          * Gets the size (number of dimensions) of the vector.
          * @return The size of the vector.
@@ -59,6 +93,28 @@ namespace mylib
             return m_data[index];
         }
 
+        /**
+         * Access operator with bounds checking in every build mode.
+         * @param index The index of the element to access.
+         * @return A reference to the element at the specified index.
+         * @throws "Index out of range" If the index is invalid.
+         */
+        T& at(size_t index)
+    	{
+            return m_data.at(index);
+        }
+
+        /**
+         * Access operator with bounds checking in every build mode (constant version).
+         * @param index The index of the element to access.
+         * @return A constant reference to the element at the specified index.
+         * @throws "Index out of range" If the index is invalid.
+         */
+        const T& at(size_t index) const
+    	{
+            return m_data.at(index);
+        }
+
         /**
          * Computes the dot product of this vector and another vector.
          * @param other The other vector to compute the dot product with.
@@ -69,10 +125,7 @@ namespace mylib
     	{
             if (size() != other.size())
                 throw "Dimension mismatch";
-            T result = 0;
-            for (size_t i = 0; i < size(); ++i)
-                result += m_data[i] * other[i];
-            return result;
+            return reduce::dot(m_data.dataPointer(), other.m_data.dataPointer(), size());
         }
 
         /**
@@ -98,7 +151,86 @@ namespace mylib
          */
         T norm() const
     	{
-            return std::sqrt(dot(*this));
+            return std::sqrt(reduce::sumSquares(m_data.dataPointer(), size()));
+        }
+
+        /**
+         * Computes the 1-norm (sum of absolute values) of the vector.
+         * @return The 1-norm of the vector.
+         */
+        T norm1() const
+    	{
+            return reduce::sumAbs(m_data.dataPointer(), size());
+        }
+
+        /**
+         * Computes the infinity norm (largest absolute value) of the vector.
+         * @return The infinity norm of the vector.
+         */
+        T normInf() const
+    	{
+            if (size() == 0)
+                return T(0);
+            T largest = simd::absValue(max());
+            T smallest = simd::absValue(min());
+            return largest < smallest ? smallest : largest;
+        }
+
+        /**
+         * Sums the elements of the vector.
+         * @return The sum of the elements.
+         */
+        T sum() const
+    	{
+            return reduce::sum(m_data.dataPointer(), size());
+        }
+
+        /**
+         * Gets the smallest element of the vector.
+         * @return The minimum.
+         * @throws "Vector is empty" If the vector has no elements.
+         */
+        T min() const
+    	{
+            if (size() == 0)
+                throw "Vector is empty";
+            return reduce::minValue(m_data.dataPointer(), size());
+        }
+
+        /**
+         * Gets the largest element of the vector.
+         * @return The maximum.
+         * @throws "Vector is empty" If the vector has no elements.
+         */
+        T max() const
+    	{
+            if (size() == 0)
+                throw "Vector is empty";
+            return reduce::maxValue(m_data.dataPointer(), size());
+        }
+
+        /**
+         * Gets the index of the first smallest element of the vector.
+         * @return The index of the minimum.
+         * @throws "Vector is empty" If the vector has no elements.
+         */
+        size_t argmin() const
+    	{
+            if (size() == 0)
+                throw "Vector is empty";
+            return reduce::argMin(m_data.dataPointer(), size());
+        }
+
+        /**
+         * Gets the index of the first largest element of the vector.
+         * @return The index of the maximum.
+         * @throws "Vector is empty" If the vector has no elements.
+         */
+        size_t argmax() const
+    	{
+            if (size() == 0)
+                throw "Vector is empty";
+            return reduce::argMax(m_data.dataPointer(), size());
         }
 
         /**
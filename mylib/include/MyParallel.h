@@ -0,0 +1,92 @@
+#ifndef MYLIB_PARALLEL_H
+#define MYLIB_PARALLEL_H
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace mylib
+{
+    namespace parallel
+    {
+        /**
+         * Gets the number of worker threads used by the parallel kernels.
+         * @return The hardware concurrency, or 1 if it cannot be determined.
+         */
+        inline size_t workerCount()
+        {
+            unsigned int count = std::thread::hardware_concurrency();
+            return count == 0 ? 1 : count;
+        }
+
+        /**
+         * Gets the number of chunks forChunks() splits a range into.
+         * @param count The number of items in the range.
+         * @param minChunk The smallest chunk worth handing to a thread.
+         * @return The number of chunks (0 for an empty range).
+         */
+        inline size_t chunkCount(size_t count, size_t minChunk)
+        {
+            if (count == 0)
+                return 0;
+            if (minChunk == 0)
+                minChunk = 1;
+            size_t workers = count / minChunk;
+            if (workers > workerCount())
+                workers = workerCount();
+            return workers <= 1 ? 1 : workers;
+        }
+
+        /**
+         * Splits the range [0, count) into chunkCount() contiguous chunks, in order, and
+         * runs them on worker threads. A single chunk runs inline on the calling thread.
+         * @param count The number of items in the range.
+         * @param minChunk The smallest chunk worth handing to a thread.
+         * @param body Callable invoked as body(chunk, begin, end) for each chunk.
+         */
+        template <typename F>
+        void forChunks(size_t count, size_t minChunk, F body)
+        {
+            const size_t workers = chunkCount(count, minChunk);
+            if (workers <= 1)
+            {
+                if (count > 0)
+                    body(size_t(0), size_t(0), count);
+                return;
+            }
+
+            const size_t chunk = count / workers;
+            const size_t remainder = count % workers;
+            std::vector<std::thread> threads;
+            threads.reserve(workers - 1);
+
+            size_t begin = 0;
+            for (size_t w = 0; w + 1 < workers; ++w)
+            {
+                size_t end = begin + chunk + (w < remainder ? 1 : 0);
+                threads.emplace_back([=, &body]() { body(w, begin, end); });
+                begin = end;
+            }
+            body(workers - 1, begin, count);
+
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+
+        /**
+         * Splits the range [0, count) into contiguous chunks and runs them on worker threads.
+         * Ranges too small to give every worker at least minChunk items use fewer workers,
+         * and a range below minChunk runs inline on the calling thread.
+         * @param count The number of items in the range.
+         * @param minChunk The smallest chunk worth handing to a thread.
+         * @param body Callable invoked as body(begin, end) for each chunk.
+         */
+        template <typename F>
+        void forRange(size_t count, size_t minChunk, F body)
+        {
+            forChunks(count, minChunk, [&body](size_t, size_t begin, size_t end) { body(begin, end); });
+        }
+    } // namespace parallel
+} // namespace mylib
+
+#endif // MYLIB_PARALLEL_H
@@ -0,0 +1,202 @@
+#ifndef MYLIB_REDUCE_H
+#define MYLIB_REDUCE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "MyParallel.h"
+#include "MySimd.h"
+
+namespace mylib
+{
+    /**
+     * Reductions over contiguous ranges. Each one runs the serial SIMD kernel
+     * directly for small ranges and splits large ranges across worker threads.
+     * Each chunk's partial result goes into its own slot and the slots are combined
+     * in chunk order after the join, so a result never depends on thread timing.
+     */
+    namespace reduce
+    {
+        /// Elements per worker below which a reduction stays on the calling thread.
+        constexpr size_t kParallelChunk = size_t(1) << 17;
+
+        /**
+         * Runs a kernel over [0, count), in parallel when there are at least two chunks of work.
+         * @param count The number of items (must be at least 1).
+         * @param minChunk The smallest number of items worth handing to a thread.
+         * @param kernel Callable returning the partial result of [begin, end).
+         * @param merge Callable combining two partial results.
+         * @return The combined result.
+         */
+        template <typename T, typename Kernel, typename Merge>
+        T combine(size_t count, size_t minChunk, Kernel kernel, Merge merge)
+        {
+            if (count < 2 * minChunk)
+                return kernel(size_t(0), count);
+            std::vector<T> partials(parallel::chunkCount(count, minChunk));
+            parallel::forChunks(count, minChunk, [&](size_t chunk, size_t begin, size_t end)
+            {
+                partials[chunk] = kernel(begin, end);
+            });
+            T total = partials[0];
+            for (size_t chunk = 1; chunk < partials.size(); ++chunk)
+                total = merge(total, partials[chunk]);
+            return total;
+        }
+
+        /**
+         * Runs a kernel over [0, count) elements, in parallel for large ranges.
+         */
+        template <typename T, typename Kernel, typename Merge>
+        T combine(size_t count, Kernel kernel, Merge merge)
+        {
+            return combine<T>(count, kParallelChunk, kernel, merge);
+        }
+
+        /**
+         * Runs a sum-like kernel over [0, count), in parallel for large ranges.
+         * @param count The number of elements.
+         * @param kernel Callable returning the partial sum of [begin, end).
+         * @return The total.
+         */
+        template <typename T, typename Kernel>
+        T combineSums(size_t count, Kernel kernel)
+        {
+            if (count == 0)
+                return T(0);
+            return combine<T>(count, kernel, [](const T& a, const T& b) { return a + b; });
+        }
+
+        /**
+         * Runs an arg-extremum kernel over [0, count), in parallel for large ranges.
+         * Ties resolve to the smallest index and the first NaN wins, as in the serial kernel.
+         * @param data Pointer to the first element.
+         * @param count The number of elements (must be at least 1).
+         * @param kernel Serial kernel returning the index of the extremum of a range.
+         * @param better Returns true if its first argument beats the second.
+         * @return The index of the extremum.
+         */
+        template <typename T, typename Kernel, typename Better>
+        size_t combineArg(const T* data, size_t count, Kernel kernel, Better better)
+        {
+            if (count < 2 * kParallelChunk)
+                return kernel(data, count);
+            std::vector<size_t> partials(parallel::chunkCount(count, kParallelChunk));
+            parallel::forChunks(count, kParallelChunk, [&](size_t chunk, size_t begin, size_t end)
+            {
+                partials[chunk] = begin + kernel(data + begin, end - begin);
+            });
+            size_t bestIndex = partials[0];
+            for (size_t chunk = 1; chunk < partials.size() && !simd::isNaN(data[bestIndex]); ++chunk)
+            {
+                // Strictly better, so ties keep the earlier chunk; the first NaN wins outright
+                if (better(data[partials[chunk]], data[bestIndex]) || simd::isNaN(data[partials[chunk]]))
+                    bestIndex = partials[chunk];
+            }
+            return bestIndex;
+        }
+
+        /**
+         * Sums a range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements.
+         * @return The sum.
+         */
+        template <typename T>
+        T sum(const T* data, size_t count)
+        {
+            return combineSums<T>(count, [=](size_t begin, size_t end) { return simd::sum(data + begin, end - begin); });
+        }
+
+        /**
+         * Sums the absolute values of a range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements.
+         * @return The sum of |data[i]|.
+         */
+        template <typename T>
+        T sumAbs(const T* data, size_t count)
+        {
+            return combineSums<T>(count, [=](size_t begin, size_t end) { return simd::sumAbs(data + begin, end - begin); });
+        }
+
+        /**
+         * Sums the squares of a range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements.
+         * @return The sum of data[i] * data[i].
+         */
+        template <typename T>
+        T sumSquares(const T* data, size_t count)
+        {
+            return combineSums<T>(count, [=](size_t begin, size_t end) { return simd::sumSquares(data + begin, end - begin); });
+        }
+
+        /**
+         * Computes the dot product of two ranges of the same length.
+         * @param lhs Pointer to the first range.
+         * @param rhs Pointer to the second range.
+         * @param count The number of elements.
+         * @return The sum of lhs[i] * rhs[i].
+         */
+        template <typename T>
+        T dot(const T* lhs, const T* rhs, size_t count)
+        {
+            return combineSums<T>(count, [=](size_t begin, size_t end) { return simd::dot(lhs + begin, rhs + begin, end - begin); });
+        }
+
+        /**
+         * Finds the smallest value of a non-empty range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements (must be at least 1).
+         * @return The minimum, or NaN if any element is NaN.
+         */
+        template <typename T>
+        T minValue(const T* data, size_t count)
+        {
+            return combine<T>(count, [=](size_t begin, size_t end) { return simd::minValue(data + begin, end - begin); },
+                [](const T& a, const T& b) { return simd::minOf(a, b); });
+        }
+
+        /**
+         * Finds the largest value of a non-empty range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements (must be at least 1).
+         * @return The maximum, or NaN if any element is NaN.
+         */
+        template <typename T>
+        T maxValue(const T* data, size_t count)
+        {
+            return combine<T>(count, [=](size_t begin, size_t end) { return simd::maxValue(data + begin, end - begin); },
+                [](const T& a, const T& b) { return simd::maxOf(a, b); });
+        }
+
+        /**
+         * Finds the index of the first smallest element of a non-empty range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements (must be at least 1).
+         * @return The index of the minimum, or of the first NaN.
+         */
+        template <typename T>
+        size_t argMin(const T* data, size_t count)
+        {
+            return combineArg(data, count, [](const T* d, size_t n) { return simd::argMin(d, n); },
+                [](const T& a, const T& b) { return a < b; });
+        }
+
+        /**
+         * Finds the index of the first largest element of a non-empty range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements (must be at least 1).
+         * @return The index of the maximum, or of the first NaN.
+         */
+        template <typename T>
+        size_t argMax(const T* data, size_t count)
+        {
+            return combineArg(data, count, [](const T* d, size_t n) { return simd::argMax(d, n); },
+                [](const T& a, const T& b) { return b < a; });
+        }
+    } // namespace reduce
+} // namespace mylib
+
+#endif // MYLIB_REDUCE_H
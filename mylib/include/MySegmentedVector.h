@@ -0,0 +1,659 @@
+#ifndef MYLIB_SEGMENTED_VECTOR_H
+#define MYLIB_SEGMENTED_VECTOR_H
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "MyConfig.h"
+#include "MyMemory.h"
+
+namespace mylib
+{
+    // Vector made of fixed-size blocks reached through an index table, like a deque.
+    // Elements never move once constructed: growing at either end allocates one block and
+    // at worst reallocates the table of block pointers, so push_back and push_front cost O(1)
+    // with no latency spike proportional to the size, and references to elements stay valid
+    // across pushes and pops at the ends (iterators are invalidated when the table is
+    // reallocated). Random access is one shift and one mask away from the table.
+    // One emptied block is kept as a spare so pushes and pops at a block boundary do not
+    // allocate and free repeatedly.
+    // Blocks come from an optional std::pmr::memory_resource (the global heap by default).
+    // Param: T - The type of elements stored in the vector.
+    template <typename T>
+    class SegmentedVector {
+    public:
+        // Number of elements per block: a power of two covering about 4 KiB, at least 16.
+        static constexpr size_t blockSize = sizeof(T) <= 4096 / 16 ? std::bit_floor(4096 / sizeof(T)) : 16;
+
+        // Default constructor initializes an empty vector with no allocated memory.
+        // Param: resource - The memory resource for the blocks, or nullptr for the global heap.
+        explicit SegmentedVector(std::pmr::memory_resource* resource = nullptr)
+            : m_map(nullptr), m_mapCapacity(0), m_firstBlock(0), m_blockCount(0), m_start(0), m_size(0),
+            m_spare(nullptr), m_resource(resource) {}
+
+        // Copy constructor.
+        // Param: other - The vector to copy from.
+        // Param: resource - The memory resource for the copy, or nullptr for the global heap.
+        SegmentedVector(const SegmentedVector& other, std::pmr::memory_resource* resource = nullptr) : SegmentedVector(resource)
+        {
+            for (size_t i = 0; i < other.m_size; ++i)
+                emplace_back(other[i]);
+        }
+
+        // Move constructor. Takes over the blocks (and memory resource) of another vector.
+        // Param: other - The vector to move from (left empty).
+        SegmentedVector(SegmentedVector&& other) noexcept : SegmentedVector(other.m_resource)
+        {
+            swap(other);
+        }
+
+        // Assignment operator. The copy is allocated from this vector's memory resource.
+        // Param: other - The vector to copy from.
+        // Returns: A reference to this vector after copying.
+        SegmentedVector& operator=(const SegmentedVector& other)
+        {
+            if (this != &other)
+            {
+                SegmentedVector copy(other, m_resource);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        // Move assignment operator. Takes over the blocks (and memory resource) of another vector.
+        // Param: other - The vector to move from (left empty).
+        // Returns: A reference to this vector after moving.
+        SegmentedVector& operator=(SegmentedVector&& other) noexcept
+        {
+            if (this != &other)
+            {
+                SegmentedVector moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+
+        // Destructor to destroy the elements and release the blocks and the table.
+        ~SegmentedVector()
+        {
+            clear();
+            releaseBlock(m_spare);
+            memory::deallocateArray(m_resource, m_map, m_mapCapacity);
+        }
+
+        // Returns the memory resource that owns the blocks (nullptr for the global heap).
+        std::pmr::memory_resource* resource() const
+        {
+            return m_resource;
+        }
+
+        // Adds a new element to the end of the vector.
+        // Param: value - The value to add to the vector.
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        // Adds a new element to the end of the vector by moving from value.
+        // Param: value - The value to move into the vector.
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        // Constructs a new element in place at the end of the vector.
+        // Param: args - The constructor arguments.
+        // Returns: A reference to the new element.
+        // Throws: std::bad_alloc if the vector is full or a block cannot be allocated.
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (m_size == max_size())
+                throw std::bad_alloc();
+            const size_t position = m_start + m_size;
+            const bool newBlock = (position >> kBlockShift) == m_blockCount;
+            if (newBlock)
+                addBackBlock();
+            try
+            {
+                T* element = ::new (static_cast<void*>(slot(position))) T(std::forward<Args>(args)...);
+                ++m_size;
+                return *element;
+            }
+            catch (...)
+            {
+                if (newBlock)
+                    removeBackBlock();
+                throw;
+            }
+        }
+
+        // Adds a new element to the front of the vector.
+        // Param: value - The value to add to the vector.
+        void push_front(const T& value)
+        {
+            emplace_front(value);
+        }
+
+        // Adds a new element to the front of the vector by moving from value.
+        // Param: value - The value to move into the vector.
+        void push_front(T&& value)
+        {
+            emplace_front(std::move(value));
+        }
+
+        // Constructs a new element in place at the front of the vector.
+        // Param: args - The constructor arguments.
+        // Returns: A reference to the new element.
+        // Throws: std::bad_alloc if the vector is full or a block cannot be allocated.
+        template <typename... Args>
+        T& emplace_front(Args&&... args)
+        {
+            if (m_size == max_size())
+                throw std::bad_alloc();
+            const bool newBlock = m_start == 0;
+            if (newBlock)
+            {
+                addFrontBlock();
+                m_start = blockSize;
+            }
+            try
+            {
+                T* element = ::new (static_cast<void*>(slot(m_start - 1))) T(std::forward<Args>(args)...);
+                --m_start;
+                ++m_size;
+                return *element;
+            }
+            catch (...)
+            {
+                if (newBlock)
+                {
+                    m_start = 0;
+                    removeFrontBlock();
+                }
+                throw;
+            }
+        }
+
+        // Removes the last element from the vector.
+        void pop_back()
+        {
+            if (m_size == 0)
+                return;
+            slot(m_start + --m_size)->~T();
+            if (m_size == 0)
+                resetEmpty();
+            else if (((m_start + m_size - 1) >> kBlockShift) + 1 < m_blockCount)
+                removeBackBlock();
+        }
+
+        // Removes the first element from the vector.
+        void pop_front()
+        {
+            if (m_size == 0)
+                return;
+            slot(m_start)->~T();
+            --m_size;
+            if (m_size == 0)
+                resetEmpty();
+            else if (++m_start == blockSize)
+            {
+                removeFrontBlock();
+                m_start = 0;
+            }
+        }
+
+        // Clears the vector, destroying its elements; one block is kept as a spare.
+        void clear()
+        {
+            for (size_t block = 0; block < m_blockCount; ++block)
+            {
+                T* data = m_map[m_firstBlock + block];
+                const size_t first = block == 0 ? m_start : 0;
+                const size_t last = std::min(blockSize, m_start + m_size - block * blockSize);
+                std::destroy(data + first, data + last);
+                if (block + 1 < m_blockCount || m_spare != nullptr)
+                    releaseBlock(data);
+                else
+                    m_spare = data;
+            }
+            m_blockCount = 0;
+            m_size = 0;
+            m_start = 0;
+            m_firstBlock = m_mapCapacity / 2;
+        }
+
+        // Inserts an element at a specific index, shifting the later elements back.
+        // Param: index - The index at which to insert the element.
+        // Param: value - The value to insert.
+        // Throws: "Index out of range" if the index is greater than the size.
+        void insert(size_t index, const T& value)
+        {
+            if (index > m_size)
+                throw "Index out of range";
+            emplace_back(value);
+            std::rotate(begin() + index, end() - 1, end());
+        }
+
+        // Erases an element at a specific index, shifting the later elements forward.
+        // Param: index - The index of the element to erase.
+        // Throws: "Index out of range" if the index is invalid.
+        void erase(size_t index)
+        {
+            if (index >= m_size)
+                throw "Index out of range";
+            std::move(begin() + index + 1, end(), begin() + index);
+            pop_back();
+        }
+
+        // Resizes the vector, value-initializing new elements or destroying the excess ones.
+        // Param: newSize - The new size of the vector.
+        void resize(size_t newSize)
+        {
+            while (m_size > newSize)
+                pop_back();
+            while (m_size < newSize)
+                emplace_back();
+        }
+
+        // Releases the spare block and shrinks the block table to the blocks in use.
+        void shrink_to_fit()
+        {
+            releaseBlock(m_spare);
+            m_spare = nullptr;
+            if (m_mapCapacity > m_blockCount + 2)
+                reallocateMap(m_blockCount + 2);
+        }
+
+        // Get the size of the vector.
+        // Returns: The size of the vector.
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        // Get the largest number of elements the vector can hold.
+        // Returns: The maximum size.
+        size_t max_size() const
+        {
+            return (std::numeric_limits<size_t>::max() / 2 - blockSize) / sizeof(T);
+        }
+
+        // Get the number of blocks holding elements.
+        // Returns: The number of blocks in use.
+        size_t blockCount() const
+        {
+            return m_blockCount;
+        }
+
+        // Check if the vector is empty.
+        // Returns: True if the vector is empty, false otherwise.
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        // Access element at a specific index (always checked).
+        // Param: index - The index of the element to access.
+        // Returns: A reference to the element at the specified index.
+        // Throws: "Index out of range" if the index is invalid.
+        T& at(size_t index)
+        {
+            detail::checkIndexAlways(index, m_size);
+            return *slot(m_start + index);
+        }
+
+        // Access element at a specific index (always checked).
+        // Param: index - The index of the element to access.
+        // Returns: A const reference to the element at the specified index.
+        // Throws: "Index out of range" if the index is invalid.
+        const T& at(size_t index) const
+        {
+            detail::checkIndexAlways(index, m_size);
+            return *slot(m_start + index);
+        }
+
+        // Access the first element of the vector.
+        // Returns: A reference to the first element.
+        T& front()
+        {
+            return (*this)[0];
+        }
+
+        // Access the first element of the vector.
+        // Returns: A const reference to the first element.
+        const T& front() const
+        {
+            return (*this)[0];
+        }
+
+        // Access the last element of the vector.
+        // Returns: A reference to the last element.
+        T& back()
+        {
+            return (*this)[m_size - 1];
+        }
+
+        // Access the last element of the vector.
+        // Returns: A const reference to the last element.
+        const T& back() const
+        {
+            return (*this)[m_size - 1];
+        }
+
+        // Access element at a specific index (checked in debug builds).
+        // Param: index - The index of the element to access.
+        // Returns: A reference to the element at the specified index.
+        // Throws: "Index out of range" if the index is invalid (checked builds only).
+        T& operator[](size_t index)
+        {
+            detail::checkIndex(index, m_size);
+            return *slot(m_start + index);
+        }
+
+        // Access element at a specific index (checked in debug builds).
+        // Param: index - The index of the element to access.
+        // Returns: A const reference to the element at the specified index.
+        // Throws: "Index out of range" if the index is invalid (checked builds only).
+        const T& operator[](size_t index) const
+        {
+            detail::checkIndex(index, m_size);
+            return *slot(m_start + index);
+        }
+
+        // Equality operator to compare two vectors.
+        // Param: other - The vector to compare with.
+        // Returns: True if vectors are equal, false otherwise.
+        bool operator==(const SegmentedVector& other) const
+        {
+            return m_size == other.m_size && std::equal(begin(), end(), other.begin());
+        }
+
+        // Inequality operator to compare two vectors.
+        // Param: other - The vector to compare with.
+        // Returns: True if vectors are not equal, false otherwise.
+        bool operator!=(const SegmentedVector& other) const
+        {
+            return !(*this == other);
+        }
+
+        // Less-than operator to compare two vectors lexicographically.
+        // Param: other - The vector to compare with.
+        // Returns: True if this vector is less than the other vector, false otherwise.
+        bool operator<(const SegmentedVector& other) const
+        {
+            return std::lexicographical_compare(begin(), end(), other.begin(), other.end());
+        }
+
+        // Swaps the contents (and memory resources) of two vectors.
+        // Param: other - The vector to swap with.
+        void swap(SegmentedVector& other) noexcept
+        {
+            std::swap(m_map, other.m_map);
+            std::swap(m_mapCapacity, other.m_mapCapacity);
+            std::swap(m_firstBlock, other.m_firstBlock);
+            std::swap(m_blockCount, other.m_blockCount);
+            std::swap(m_start, other.m_start);
+            std::swap(m_size, other.m_size);
+            std::swap(m_spare, other.m_spare);
+            std::swap(m_resource, other.m_resource);
+        }
+
+        // Random-access iterator. It holds the first table entry in use and a position
+        // counted from the start of the first block, so it stays valid across pushes and
+        // pops that do not reallocate the table.
+        template <typename U>
+        class BasicIterator {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_cv_t<U>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = U*;
+            using reference = U&;
+
+            BasicIterator() : m_blocks(nullptr), m_position(0) {}
+
+            BasicIterator(T* const* blocks, size_t position)
+                : m_blocks(blocks), m_position(static_cast<difference_type>(position)) {}
+
+            // Converts a mutable iterator to a const one.
+            template <typename V>
+                requires (std::is_same_v<const V, U> && !std::is_same_v<V, U>)
+            BasicIterator(const BasicIterator<V>& other) : m_blocks(other.blocks()), m_position(other.position()) {}
+
+            U& operator*() const
+            {
+                return m_blocks[m_position >> kBlockShift][m_position & kBlockMask];
+            }
+
+            U* operator->() const
+            {
+                return &**this;
+            }
+
+            U& operator[](difference_type offset) const
+            {
+                return *(*this + offset);
+            }
+
+            BasicIterator& operator++()
+            {
+                ++m_position; return *this;
+            }
+
+            BasicIterator operator++(int)
+            {
+                BasicIterator tmp = *this; ++(*this);
+                return tmp;
+            }
+
+            BasicIterator& operator--()
+            {
+                --m_position; return *this;
+            }
+
+            BasicIterator operator--(int)
+            {
+                BasicIterator tmp = *this; --(*this);
+                return tmp;
+            }
+
+            BasicIterator& operator+=(difference_type offset)
+            {
+                m_position += offset; return *this;
+            }
+
+            BasicIterator& operator-=(difference_type offset)
+            {
+                m_position -= offset; return *this;
+            }
+
+            friend BasicIterator operator+(BasicIterator it, difference_type offset)
+            {
+                return it += offset;
+            }
+
+            friend BasicIterator operator+(difference_type offset, BasicIterator it)
+            {
+                return it += offset;
+            }
+
+            friend BasicIterator operator-(BasicIterator it, difference_type offset)
+            {
+                return it -= offset;
+            }
+
+            friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs)
+            {
+                return lhs.m_position - rhs.m_position;
+            }
+
+            friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs)
+            {
+                return lhs.m_position == rhs.m_position;
+            }
+
+            friend std::strong_ordering operator<=>(const BasicIterator& lhs, const BasicIterator& rhs)
+            {
+                return lhs.m_position <=> rhs.m_position;
+            }
+
+            T* const* blocks() const
+            {
+                return m_blocks;
+            }
+
+            difference_type position() const
+            {
+                return m_position;
+            }
+
+        private:
+            T* const* m_blocks;
+            difference_type m_position;
+        };
+
+        using Iterator = BasicIterator<T>;
+        using ConstIterator = BasicIterator<const T>;
+
+        Iterator begin()
+        {
+            return Iterator(m_map + m_firstBlock, m_start);
+        }
+
+        Iterator end()
+        {
+            return Iterator(m_map + m_firstBlock, m_start + m_size);
+        }
+
+        ConstIterator begin() const
+        {
+            return ConstIterator(m_map + m_firstBlock, m_start);
+        }
+
+        ConstIterator end() const
+        {
+            return ConstIterator(m_map + m_firstBlock, m_start + m_size);
+        }
+
+    private:
+        static constexpr size_t kBlockShift = std::countr_zero(blockSize);
+        static constexpr size_t kBlockMask = blockSize - 1;
+
+        T** m_map;                             // Table of block pointers
+        size_t m_mapCapacity;                  // Number of entries in the table
+        size_t m_firstBlock;                   // Table entry of the first block in use
+        size_t m_blockCount;                   // Number of blocks in use
+        size_t m_start;                        // Offset of the first element in the first block
+        size_t m_size;                         // Number of elements
+        T* m_spare;                            // Emptied block kept for the next growth, or nullptr
+        std::pmr::memory_resource* m_resource; // Source of the blocks, or nullptr for the global heap
+
+        // Address of the slot at a position counted from the start of the first block.
+        T* slot(size_t position) const
+        {
+            return m_map[m_firstBlock + (position >> kBlockShift)] + (position & kBlockMask);
+        }
+
+        T* acquireBlock()
+        {
+            if (m_spare != nullptr)
+                return std::exchange(m_spare, nullptr);
+            return memory::allocateArray<T>(m_resource, blockSize);
+        }
+
+        // Keeps a freed block as the spare, or releases it if there already is one.
+        void recycleBlock(T* block)
+        {
+            if (m_spare == nullptr)
+                m_spare = block;
+            else
+                releaseBlock(block);
+        }
+
+        void releaseBlock(T* block)
+        {
+            memory::deallocateArray(m_resource, block, blockSize);
+        }
+
+        // Appends a block to the table.
+        void addBackBlock()
+        {
+            if (m_firstBlock + m_blockCount == m_mapCapacity)
+                rebalanceMap();
+            m_map[m_firstBlock + m_blockCount] = acquireBlock();
+            ++m_blockCount;
+        }
+
+        // Prepends a block to the table.
+        void addFrontBlock()
+        {
+            if (m_firstBlock == 0)
+                rebalanceMap();
+            m_map[m_firstBlock - 1] = acquireBlock();
+            --m_firstBlock;
+            ++m_blockCount;
+        }
+
+        void removeBackBlock()
+        {
+            --m_blockCount;
+            recycleBlock(m_map[m_firstBlock + m_blockCount]);
+        }
+
+        void removeFrontBlock()
+        {
+            recycleBlock(m_map[m_firstBlock]);
+            ++m_firstBlock;
+            --m_blockCount;
+        }
+
+        // Called once the last element is gone: recycles the remaining block and recenters.
+        void resetEmpty()
+        {
+            while (m_blockCount > 0)
+                removeBackBlock();
+            m_start = 0;
+            m_firstBlock = m_mapCapacity / 2;
+        }
+
+        // Makes room for a block at both ends of the table: recenters the blocks in use if
+        // the table is at most half full, else reallocates it at twice the size. Only block
+        // pointers move, never elements.
+        void rebalanceMap()
+        {
+            if ((m_blockCount + 2) * 2 <= m_mapCapacity)
+            {
+                const size_t first = (m_mapCapacity - m_blockCount) / 2;
+                std::memmove(m_map + first, m_map + m_firstBlock, m_blockCount * sizeof(T*));
+                m_firstBlock = first;
+            }
+            else
+                reallocateMap(std::max<size_t>(8, (m_blockCount + 1) * 2));
+        }
+
+        // Moves the blocks in use to the middle of a new table.
+        void reallocateMap(size_t capacity)
+        {
+            T** map = memory::allocateArray<T*>(m_resource, capacity);
+            const size_t first = (capacity - m_blockCount) / 2;
+            if (m_blockCount > 0)
+                std::memcpy(map + first, m_map + m_firstBlock, m_blockCount * sizeof(T*));
+            memory::deallocateArray(m_resource, m_map, m_mapCapacity);
+            m_map = map;
+            m_mapCapacity = capacity;
+            m_firstBlock = first;
+        }
+    };
+} // namespace mylib
+
+#endif // MYLIB_SEGMENTED_VECTOR_H
@@ -0,0 +1,785 @@
+#ifndef MYLIB_SIMD_H
+#define MYLIB_SIMD_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYLIB_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace mylib
+{
+    /**
+     * Serial vectorized kernels over contiguous ranges.
+     * The generic versions keep four independent accumulators so the compiler can
+     * vectorize integer loops and overlap the latency of floating-point adds;
+     * float and double use SSE2 explicitly where it is available.
+     * Minimum and maximum propagate NaN: if any element is NaN the result is NaN,
+     * and argMin()/argMax() return the index of the first NaN.
+     */
+    namespace simd
+    {
+        /**
+         * Absolute value that also works for unsigned types.
+         */
+        template <typename T>
+        T absValue(const T& value)
+        {
+            return value < T(0) ? -value : value;
+        }
+
+        /**
+         * NaN test that is always false for types without NaN.
+         */
+        template <typename T>
+        bool isNaN(const T& value)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+                return value != value;
+            else
+                return false;
+        }
+
+        /**
+         * The smaller of two values, or NaN if either is NaN.
+         */
+        template <typename T>
+        T minOf(const T& a, const T& b)
+        {
+            return b < a || isNaN(b) ? b : a;
+        }
+
+        /**
+         * The larger of two values, or NaN if either is NaN.
+         */
+        template <typename T>
+        T maxOf(const T& a, const T& b)
+        {
+            return a < b || isNaN(b) ? b : a;
+        }
+
+        /**
+         * Sums a range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements.
+         * @return The sum of the elements (zero for an empty range).
+         */
+        template <typename T>
+        T sum(const T* data, size_t count)
+        {
+            T acc0 = T(0), acc1 = T(0), acc2 = T(0), acc3 = T(0);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                acc0 += data[i];
+                acc1 += data[i + 1];
+                acc2 += data[i + 2];
+                acc3 += data[i + 3];
+            }
+            for (; i < count; ++i)
+                acc0 += data[i];
+            return (acc0 + acc1) + (acc2 + acc3);
+        }
+
+        /**
+         * Computes the dot product of two ranges of the same length.
+         * @param lhs Pointer to the first range.
+         * @param rhs Pointer to the second range.
+         * @param count The number of elements.
+         * @return The sum of lhs[i] * rhs[i].
+         */
+        template <typename T>
+        T dot(const T* lhs, const T* rhs, size_t count)
+        {
+            T acc0 = T(0), acc1 = T(0), acc2 = T(0), acc3 = T(0);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                acc0 += lhs[i] * rhs[i];
+                acc1 += lhs[i + 1] * rhs[i + 1];
+                acc2 += lhs[i + 2] * rhs[i + 2];
+                acc3 += lhs[i + 3] * rhs[i + 3];
+            }
+            for (; i < count; ++i)
+                acc0 += lhs[i] * rhs[i];
+            return (acc0 + acc1) + (acc2 + acc3);
+        }
+
+        /**
+         * Sums the squares of a range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements.
+         * @return The sum of data[i] * data[i].
+         */
+        template <typename T>
+        T sumSquares(const T* data, size_t count)
+        {
+            return dot(data, data, count);
+        }
+
+        /**
+         * Sums the absolute values of a range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements.
+         * @return The sum of |data[i]|.
+         */
+        template <typename T>
+        T sumAbs(const T* data, size_t count)
+        {
+            T acc0 = T(0), acc1 = T(0), acc2 = T(0), acc3 = T(0);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                acc0 += absValue(data[i]);
+                acc1 += absValue(data[i + 1]);
+                acc2 += absValue(data[i + 2]);
+                acc3 += absValue(data[i + 3]);
+            }
+            for (; i < count; ++i)
+                acc0 += absValue(data[i]);
+            return (acc0 + acc1) + (acc2 + acc3);
+        }
+
+        /**
+         * Finds the smallest value of a non-empty range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements (must be at least 1).
+         * @return The minimum, or NaN if any element is NaN.
+         */
+        template <typename T>
+        T minValue(const T* data, size_t count)
+        {
+            T m0 = data[0], m1 = data[0], m2 = data[0], m3 = data[0];
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                m0 = minOf(m0, data[i]);
+                m1 = minOf(m1, data[i + 1]);
+                m2 = minOf(m2, data[i + 2]);
+                m3 = minOf(m3, data[i + 3]);
+            }
+            for (; i < count; ++i)
+                m0 = minOf(m0, data[i]);
+            return minOf(minOf(m0, m1), minOf(m2, m3));
+        }
+
+        /**
+         * Finds the largest value of a non-empty range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements (must be at least 1).
+         * @return The maximum, or NaN if any element is NaN.
+         */
+        template <typename T>
+        T maxValue(const T* data, size_t count)
+        {
+            T m0 = data[0], m1 = data[0], m2 = data[0], m3 = data[0];
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                m0 = maxOf(m0, data[i]);
+                m1 = maxOf(m1, data[i + 1]);
+                m2 = maxOf(m2, data[i + 2]);
+                m3 = maxOf(m3, data[i + 3]);
+            }
+            for (; i < count; ++i)
+                m0 = maxOf(m0, data[i]);
+            return maxOf(maxOf(m0, m1), maxOf(m2, m3));
+        }
+
+        /**
+         * Finds the index of the first occurrence of the smallest value of a non-empty range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements (must be at least 1).
+         * @return The index of the minimum, or of the first NaN if there is one.
+         */
+        template <typename T>
+        size_t argMin(const T* data, size_t count)
+        {
+            size_t best = 0;
+            for (size_t i = 1; i < count && !isNaN(data[best]); ++i)
+            {
+                if (data[i] < data[best] || isNaN(data[i]))
+                    best = i;
+            }
+            return best;
+        }
+
+        /**
+         * Finds the index of the first occurrence of the largest value of a non-empty range.
+         * @param data Pointer to the first element.
+         * @param count The number of elements (must be at least 1).
+         * @return The index of the maximum, or of the first NaN if there is one.
+         */
+        template <typename T>
+        size_t argMax(const T* data, size_t count)
+        {
+            size_t best = 0;
+            for (size_t i = 1; i < count && !isNaN(data[best]); ++i)
+            {
+                if (data[best] < data[i] || isNaN(data[i]))
+                    best = i;
+            }
+            return best;
+        }
+
+        /// True if equality of T is equality of its bytes, so ranges can be compared with memcmp.
+        template <typename T>
+        constexpr bool kBitwiseComparable = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+        namespace detail
+        {
+            /**
+             * Finds the first differing byte of two buffers.
+             * @return The byte offset of the first difference, or bytes if there is none.
+             */
+            inline size_t mismatchBytes(const unsigned char* lhs, const unsigned char* rhs, size_t bytes)
+            {
+                size_t i = 0;
+#ifdef MYLIB_HAS_SSE2
+                for (; i + 16 <= bytes; i += 16)
+                {
+                    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+                    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+                    const unsigned equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+                    if (equal != 0xFFFFu)
+                        return i + static_cast<size_t>(std::countr_zero(~equal));
+                }
+#endif
+                while (i < bytes && lhs[i] == rhs[i])
+                    ++i;
+                return i;
+            }
+        }
+
+        /**
+         * Finds the first position where two ranges of the same length differ under operator==.
+         * Bitwise-comparable elements are scanned 16 bytes at a time; floating-point elements
+         * follow IEEE equality, so NaN never matches and -0.0 matches 0.0.
+         * @param lhs Pointer to the first range.
+         * @param rhs Pointer to the second range.
+         * @param count The number of elements.
+         * @return The index of the first mismatch, or count if the ranges are equal.
+         */
+        template <typename T>
+        size_t mismatch(const T* lhs, const T* rhs, size_t count)
+        {
+            if constexpr (kBitwiseComparable<T>)
+                return detail::mismatchBytes(reinterpret_cast<const unsigned char*>(lhs),
+                    reinterpret_cast<const unsigned char*>(rhs), count * sizeof(T)) / sizeof(T);
+            else
+            {
+                size_t i = 0;
+                while (i < count && lhs[i] == rhs[i])
+                    ++i;
+                return i;
+            }
+        }
+
+        /**
+         * Finds the first position where two ranges of the same length are ordered, i.e. where
+         * lhs[i] < rhs[i] or lhs[i] > rhs[i]. Unordered pairs (a NaN against anything) are
+         * skipped, matching an element-by-element lexicographic loop.
+         * @param lhs Pointer to the first range.
+         * @param rhs Pointer to the second range.
+         * @param count The number of elements.
+         * @return The index of the first ordered pair, or count if there is none.
+         */
+        template <typename T>
+        size_t orderMismatch(const T* lhs, const T* rhs, size_t count)
+        {
+            if constexpr (kBitwiseComparable<T>)
+                return mismatch(lhs, rhs, count);
+            else
+            {
+                size_t i = 0;
+                while (i < count && !(lhs[i] < rhs[i]) && !(lhs[i] > rhs[i]))
+                    ++i;
+                return i;
+            }
+        }
+
+        /**
+         * Compares two ranges lexicographically, deciding at the first ordered pair.
+         * @param lhs Pointer to the first range.
+         * @param lhsCount The length of the first range.
+         * @param rhs Pointer to the second range.
+         * @param rhsCount The length of the second range.
+         * @return True if the first range orders before the second.
+         */
+        template <typename T>
+        bool lexicographicLess(const T* lhs, size_t lhsCount, const T* rhs, size_t rhsCount)
+        {
+            const size_t common = lhsCount < rhsCount ? lhsCount : rhsCount;
+            const size_t i = orderMismatch(lhs, rhs, common);
+            if (i < common)
+                return lhs[i] < rhs[i];
+            return lhsCount < rhsCount;
+        }
+
+        /// Bitwise operations applied word by word by combineWords().
+        enum class WordOp
+        {
+            And,    ///< dst & src
+            Or,     ///< dst | src
+            Xor,    ///< dst ^ src
+            AndNot  ///< dst & ~src
+        };
+
+        namespace detail
+        {
+            template <WordOp Op>
+            inline uint64_t applyWord(uint64_t lhs, uint64_t rhs)
+            {
+                if constexpr (Op == WordOp::And)
+                    return lhs & rhs;
+                else if constexpr (Op == WordOp::Or)
+                    return lhs | rhs;
+                else if constexpr (Op == WordOp::Xor)
+                    return lhs ^ rhs;
+                else
+                    return lhs & ~rhs;
+            }
+
+#ifdef MYLIB_HAS_SSE2
+            template <WordOp Op>
+            inline __m128i applyWords(__m128i lhs, __m128i rhs)
+            {
+                if constexpr (Op == WordOp::And)
+                    return _mm_and_si128(lhs, rhs);
+                else if constexpr (Op == WordOp::Or)
+                    return _mm_or_si128(lhs, rhs);
+                else if constexpr (Op == WordOp::Xor)
+                    return _mm_xor_si128(lhs, rhs);
+                else
+                    return _mm_andnot_si128(rhs, lhs);
+            }
+#endif
+
+            /**
+             * Counts set bits with std::popcount and four accumulators.
+             */
+            inline size_t popcountPortable(const uint64_t* data, size_t count)
+            {
+                size_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    acc0 += static_cast<size_t>(std::popcount(data[i]));
+                    acc1 += static_cast<size_t>(std::popcount(data[i + 1]));
+                    acc2 += static_cast<size_t>(std::popcount(data[i + 2]));
+                    acc3 += static_cast<size_t>(std::popcount(data[i + 3]));
+                }
+                for (; i < count; ++i)
+                    acc0 += static_cast<size_t>(std::popcount(data[i]));
+                return (acc0 + acc1) + (acc2 + acc3);
+            }
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(__POPCNT__)
+#define MYLIB_POPCNT_DISPATCH 1
+            /**
+             * Counts set bits with the POPCNT instruction, for builds that do not enable it globally.
+             * Only call it if hasPopcnt() is true.
+             */
+            __attribute__((target("popcnt"))) inline size_t popcountHardware(const uint64_t* data, size_t count)
+            {
+                size_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+                size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    acc0 += static_cast<size_t>(__builtin_popcountll(data[i]));
+                    acc1 += static_cast<size_t>(__builtin_popcountll(data[i + 1]));
+                    acc2 += static_cast<size_t>(__builtin_popcountll(data[i + 2]));
+                    acc3 += static_cast<size_t>(__builtin_popcountll(data[i + 3]));
+                }
+                for (; i < count; ++i)
+                    acc0 += static_cast<size_t>(__builtin_popcountll(data[i]));
+                return (acc0 + acc1) + (acc2 + acc3);
+            }
+
+            /**
+             * Checks once whether the CPU has the POPCNT instruction.
+             */
+            inline bool hasPopcnt()
+            {
+                static const bool supported = __builtin_cpu_supports("popcnt");
+                return supported;
+            }
+#endif
+        }
+
+        /**
+         * Combines two word ranges in place, 16 bytes at a time where SSE2 is available.
+         * @param dst The words to update.
+         * @param src The second operand, not overlapping dst unless it is dst itself.
+         * @param count The number of words.
+         */
+        template <WordOp Op>
+        void combineWords(uint64_t* dst, const uint64_t* src, size_t count)
+        {
+            size_t i = 0;
+#ifdef MYLIB_HAS_SSE2
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i + 2));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 2));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), detail::applyWords<Op>(a, c));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 2), detail::applyWords<Op>(b, d));
+            }
+#endif
+            for (; i < count; ++i)
+                dst[i] = detail::applyWord<Op>(dst[i], src[i]);
+        }
+
+        /**
+         * Inverts every bit of a word range.
+         * @param data The words to invert.
+         * @param count The number of words.
+         */
+        inline void invertWords(uint64_t* data, size_t count)
+        {
+            size_t i = 0;
+#ifdef MYLIB_HAS_SSE2
+            const __m128i ones = _mm_set1_epi32(-1);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 2));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_xor_si128(a, ones));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i + 2), _mm_xor_si128(b, ones));
+            }
+#endif
+            for (; i < count; ++i)
+                data[i] = ~data[i];
+        }
+
+        /**
+         * Counts the set bits of a word range, with the POPCNT instruction when the CPU has it
+         * (selected at run time unless the build already targets it).
+         * @param data The words.
+         * @param count The number of words.
+         * @return The number of set bits.
+         */
+        inline size_t popcountWords(const uint64_t* data, size_t count)
+        {
+#ifdef MYLIB_POPCNT_DISPATCH
+            if (detail::hasPopcnt())
+                return detail::popcountHardware(data, count);
+#endif
+            return detail::popcountPortable(data, count);
+        }
+
+        /**
+         * Finds the first word with a set bit, testing four words at a time where SSE2 is available.
+         * @param data The words.
+         * @param count The number of words.
+         * @return The index of the first non-zero word, or count if every word is zero.
+         */
+        inline size_t findNonZeroWord(const uint64_t* data, size_t count)
+        {
+            size_t i = 0;
+#ifdef MYLIB_HAS_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i any = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 2)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, zero)) != 0xFFFF)
+                    break;  // The scalar loop pins down the word.
+            }
+#endif
+            while (i < count && data[i] == 0)
+                ++i;
+            return i;
+        }
+
+#ifdef MYLIB_HAS_SSE2
+        inline double horizontalSum(__m128d v)
+        {
+            return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+        }
+
+        inline float horizontalSum(__m128 v)
+        {
+            __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+            return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+        }
+
+        template <>
+        inline double sum<double>(const double* data, size_t count)
+        {
+            __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+            __m128d acc2 = _mm_setzero_pd(), acc3 = _mm_setzero_pd();
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                acc0 = _mm_add_pd(acc0, _mm_loadu_pd(data + i));
+                acc1 = _mm_add_pd(acc1, _mm_loadu_pd(data + i + 2));
+                acc2 = _mm_add_pd(acc2, _mm_loadu_pd(data + i + 4));
+                acc3 = _mm_add_pd(acc3, _mm_loadu_pd(data + i + 6));
+            }
+            double result = horizontalSum(_mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3)));
+            for (; i < count; ++i)
+                result += data[i];
+            return result;
+        }
+
+        template <>
+        inline double dot<double>(const double* lhs, const double* rhs, size_t count)
+        {
+            __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+            __m128d acc2 = _mm_setzero_pd(), acc3 = _mm_setzero_pd();
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+                acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(lhs + i + 2), _mm_loadu_pd(rhs + i + 2)));
+                acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_loadu_pd(lhs + i + 4), _mm_loadu_pd(rhs + i + 4)));
+                acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_loadu_pd(lhs + i + 6), _mm_loadu_pd(rhs + i + 6)));
+            }
+            double result = horizontalSum(_mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3)));
+            for (; i < count; ++i)
+                result += lhs[i] * rhs[i];
+            return result;
+        }
+
+        template <>
+        inline double sumAbs<double>(const double* data, size_t count)
+        {
+            const __m128d mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+            __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+            __m128d acc2 = _mm_setzero_pd(), acc3 = _mm_setzero_pd();
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                acc0 = _mm_add_pd(acc0, _mm_and_pd(mask, _mm_loadu_pd(data + i)));
+                acc1 = _mm_add_pd(acc1, _mm_and_pd(mask, _mm_loadu_pd(data + i + 2)));
+                acc2 = _mm_add_pd(acc2, _mm_and_pd(mask, _mm_loadu_pd(data + i + 4)));
+                acc3 = _mm_add_pd(acc3, _mm_and_pd(mask, _mm_loadu_pd(data + i + 6)));
+            }
+            double result = horizontalSum(_mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3)));
+            for (; i < count; ++i)
+                result += absValue(data[i]);
+            return result;
+        }
+
+        namespace detail
+        {
+            /**
+             * Extremum of a double range. minpd/maxpd drop a NaN in their first operand,
+             * so NaNs are tracked in a separate unordered-compare mask.
+             */
+            template <bool Min>
+            inline double extremeValue(const double* data, size_t count)
+            {
+                size_t i = 0;
+                double result = data[0];
+                if (count >= 4)
+                {
+                    __m128d m0 = _mm_loadu_pd(data), m1 = _mm_loadu_pd(data + 2);
+                    __m128d nan = _mm_cmpunord_pd(m0, m1);
+                    for (i = 4; i + 4 <= count; i += 4)
+                    {
+                        const __m128d x0 = _mm_loadu_pd(data + i), x1 = _mm_loadu_pd(data + i + 2);
+                        nan = _mm_or_pd(nan, _mm_cmpunord_pd(x0, x1));
+                        m0 = Min ? _mm_min_pd(m0, x0) : _mm_max_pd(m0, x0);
+                        m1 = Min ? _mm_min_pd(m1, x1) : _mm_max_pd(m1, x1);
+                    }
+                    if (_mm_movemask_pd(nan) != 0)
+                        return std::numeric_limits<double>::quiet_NaN();
+                    m0 = Min ? _mm_min_pd(m0, m1) : _mm_max_pd(m0, m1);
+                    m1 = _mm_unpackhi_pd(m0, m0);
+                    result = _mm_cvtsd_f64(Min ? _mm_min_sd(m0, m1) : _mm_max_sd(m0, m1));
+                }
+                for (; i < count; ++i)
+                    result = Min ? minOf(result, data[i]) : maxOf(result, data[i]);
+                return result;
+            }
+
+            /**
+             * Index of the first extremum (or first NaN) of a double range, tracking
+             * the best value and its index per lane in one pass.
+             */
+            template <bool Min>
+            inline size_t extremeIndex(const double* data, size_t count)
+            {
+                if (count < 2)
+                    return 0;
+                __m128d best = _mm_loadu_pd(data);
+                __m128d bestIndex = _mm_set_pd(1.0, 0.0);
+                __m128d index = _mm_set_pd(3.0, 2.0);
+                const __m128d step = _mm_set1_pd(2.0);
+                __m128d nan = _mm_cmpunord_pd(best, best);
+                size_t i = 2;
+                for (; i + 2 <= count; i += 2)
+                {
+                    const __m128d x = _mm_loadu_pd(data + i);
+                    nan = _mm_or_pd(nan, _mm_cmpunord_pd(x, x));
+                    const __m128d take = Min ? _mm_cmplt_pd(x, best) : _mm_cmpgt_pd(x, best);
+                    best = _mm_or_pd(_mm_and_pd(take, x), _mm_andnot_pd(take, best));
+                    bestIndex = _mm_or_pd(_mm_and_pd(take, index), _mm_andnot_pd(take, bestIndex));
+                    index = _mm_add_pd(index, step);
+                }
+                if (_mm_movemask_pd(nan) != 0)
+                {
+                    size_t first = 0;
+                    while (!isNaN(data[first]))
+                        ++first;
+                    return first;
+                }
+                double values[2], indices[2];
+                _mm_storeu_pd(values, best);
+                _mm_storeu_pd(indices, bestIndex);
+                const bool second = Min ? values[1] < values[0] : values[0] < values[1];
+                size_t result = static_cast<size_t>(indices[second || (values[0] == values[1] && indices[1] < indices[0]) ? 1 : 0]);
+                for (; i < count; ++i)
+                {
+                    if (isNaN(data[i]))
+                        return i;
+                    if (Min ? data[i] < data[result] : data[result] < data[i])
+                        result = i;
+                }
+                return result;
+            }
+        } // namespace detail
+
+        template <>
+        inline double minValue<double>(const double* data, size_t count)
+        {
+            return detail::extremeValue<true>(data, count);
+        }
+
+        template <>
+        inline double maxValue<double>(const double* data, size_t count)
+        {
+            return detail::extremeValue<false>(data, count);
+        }
+
+        template <>
+        inline size_t argMin<double>(const double* data, size_t count)
+        {
+            return detail::extremeIndex<true>(data, count);
+        }
+
+        template <>
+        inline size_t argMax<double>(const double* data, size_t count)
+        {
+            return detail::extremeIndex<false>(data, count);
+        }
+
+        template <>
+        inline float sum<float>(const float* data, size_t count)
+        {
+            __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+            __m128 acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                acc0 = _mm_add_ps(acc0, _mm_loadu_ps(data + i));
+                acc1 = _mm_add_ps(acc1, _mm_loadu_ps(data + i + 4));
+                acc2 = _mm_add_ps(acc2, _mm_loadu_ps(data + i + 8));
+                acc3 = _mm_add_ps(acc3, _mm_loadu_ps(data + i + 12));
+            }
+            float result = horizontalSum(_mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+            for (; i < count; ++i)
+                result += data[i];
+            return result;
+        }
+
+        template <>
+        inline float dot<float>(const float* lhs, const float* rhs, size_t count)
+        {
+            __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+            __m128 acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i)));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(lhs + i + 4), _mm_loadu_ps(rhs + i + 4)));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(lhs + i + 8), _mm_loadu_ps(rhs + i + 8)));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(lhs + i + 12), _mm_loadu_ps(rhs + i + 12)));
+            }
+            float result = horizontalSum(_mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+            for (; i < count; ++i)
+                result += lhs[i] * rhs[i];
+            return result;
+        }
+
+        template <>
+        inline size_t mismatch<double>(const double* lhs, const double* rhs, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128d a = _mm_cmpeq_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i));
+                const __m128d b = _mm_cmpeq_pd(_mm_loadu_pd(lhs + i + 2), _mm_loadu_pd(rhs + i + 2));
+                if (_mm_movemask_pd(_mm_and_pd(a, b)) != 0x3)
+                    break;  // The scalar loop pins down the lane.
+            }
+            while (i < count && lhs[i] == rhs[i])
+                ++i;
+            return i;
+        }
+
+        template <>
+        inline size_t mismatch<float>(const float* lhs, const float* rhs, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128 a = _mm_cmpeq_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i));
+                const __m128 b = _mm_cmpeq_ps(_mm_loadu_ps(lhs + i + 4), _mm_loadu_ps(rhs + i + 4));
+                if (_mm_movemask_ps(_mm_and_ps(a, b)) != 0xF)
+                    break;
+            }
+            while (i < count && lhs[i] == rhs[i])
+                ++i;
+            return i;
+        }
+
+        template <>
+        inline size_t orderMismatch<double>(const double* lhs, const double* rhs, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128d l0 = _mm_loadu_pd(lhs + i), r0 = _mm_loadu_pd(rhs + i);
+                const __m128d l1 = _mm_loadu_pd(lhs + i + 2), r1 = _mm_loadu_pd(rhs + i + 2);
+                const __m128d ordered = _mm_or_pd(_mm_or_pd(_mm_cmplt_pd(l0, r0), _mm_cmplt_pd(r0, l0)),
+                    _mm_or_pd(_mm_cmplt_pd(l1, r1), _mm_cmplt_pd(r1, l1)));
+                if (_mm_movemask_pd(ordered) != 0)
+                    break;
+            }
+            while (i < count && !(lhs[i] < rhs[i]) && !(rhs[i] < lhs[i]))
+                ++i;
+            return i;
+        }
+
+        template <>
+        inline size_t orderMismatch<float>(const float* lhs, const float* rhs, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128 l0 = _mm_loadu_ps(lhs + i), r0 = _mm_loadu_ps(rhs + i);
+                const __m128 l1 = _mm_loadu_ps(lhs + i + 4), r1 = _mm_loadu_ps(rhs + i + 4);
+                const __m128 ordered = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(l0, r0), _mm_cmplt_ps(r0, l0)),
+                    _mm_or_ps(_mm_cmplt_ps(l1, r1), _mm_cmplt_ps(r1, l1)));
+                if (_mm_movemask_ps(ordered) != 0)
+                    break;
+            }
+            while (i < count && !(lhs[i] < rhs[i]) && !(rhs[i] < lhs[i]))
+                ++i;
+            return i;
+        }
+#endif
+    } // namespace simd
+} // namespace mylib
+
+#endif // MYLIB_SIMD_H
@@ -0,0 +1,570 @@
+#ifndef MYLIB_SMALL_VECTOR_H
+#define MYLIB_SMALL_VECTOR_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "MyBulk.h"
+#include "MyConfig.h"
+#include "MyMemory.h"
+#include "MyVector.h"
+
+namespace mylib
+{
+    // Vector with a small-buffer optimization: the first N elements live inline in
+    // the object itself and the storage only moves to the heap once the vector grows
+    // past N. Offers the same interface as Vector (and the same iterator types).
+    // Heap storage comes from an optional std::pmr::memory_resource.
+    // Param: T - The type of elements stored in the vector.
+    // Param: N - The number of elements stored inline (must be at least 1).
+    template <typename T, unsigned int N>
+    class SmallVector {
+        static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+
+    public:
+        using Iterator = typename Vector<T>::Iterator;
+        using ConstIterator = typename Vector<T>::ConstIterator;
+        using ReverseIterator = typename Vector<T>::ReverseIterator;
+        using ConstReverseIterator = typename Vector<T>::ConstReverseIterator;
+
+        // Number of elements that fit without a heap allocation.
+        static constexpr size_t inlineCapacity = N;
+
+        // Default constructor initializes an empty vector using the inline buffer.
+        SmallVector() : m_data(inlineData()), m_size(0), m_capacity(N), m_resource(nullptr) {}
+
+        // Constructor with initial capacity; allocates only if it exceeds N.
+        // Param: initialCapacity - The initial capacity for the vector.
+        // Param: resource - The memory resource for heap storage, or nullptr for the global heap.
+        explicit SmallVector(size_t initialCapacity, std::pmr::memory_resource* resource = nullptr) : SmallVector()
+        {
+            m_resource = resource;
+            reserve(initialCapacity);
+        }
+
+        // Copy constructor.
+        // Param: other - The vector to copy from.
+        // Param: resource - The memory resource for the copy, or nullptr for the global heap.
+        SmallVector(const SmallVector& other, std::pmr::memory_resource* resource = nullptr) : SmallVector()
+        {
+            m_resource = resource;
+            copyFrom(other);
+        }
+
+        // Move constructor. Steals a heap buffer (and its memory resource); inline elements are moved one by one.
+        // Param: other - The vector to move from (left empty).
+        SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector()
+        {
+            moveFrom(other);
+        }
+
+        // Assignment operator. Heap storage for the copy comes from this vector's memory resource.
+        // Param: other - The vector to copy from.
+        // Returns: A reference to this vector after copying.
+        SmallVector& operator=(const SmallVector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                copyFrom(other);
+            }
+            return *this;
+        }
+
+        // Move assignment operator.
+        // Param: other - The vector to move from (left empty).
+        // Returns: A reference to this vector after moving.
+        SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this != &other)
+            {
+                release();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        // Destructor destroys the elements and frees any heap storage.
+        ~SmallVector()
+        {
+            release();
+        }
+
+        // Adds a new element to the end of the vector, moving to the heap if the inline buffer is full.
+        // Param: value - The value to add to the vector.
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        // Adds a new element to the end of the vector by moving from value.
+        // Param: value - The value to move into the vector.
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        // Constructs a new element in place at the end of the vector, moving to the heap if the inline buffer is full.
+        // Param: args - The constructor arguments (they may refer to elements of this vector).
+        // Returns: A reference to the new element.
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            T* element;
+            if (m_size == m_capacity)
+            {
+                T copy(std::forward<Args>(args)...);  // args may refer into the buffer being reallocated
+                grow(nextCapacity());
+                element = ::new (static_cast<void*>(m_data + m_size)) T(std::move(copy));
+            }
+            else
+                element = ::new (static_cast<void*>(m_data + m_size)) T(std::forward<Args>(args)...);
+            ++m_size;
+            return *element;
+        }
+
+        // Removes the last element from the vector.
+        void pop_back()
+        {
+            if (m_size > 0)
+                m_data[--m_size].~T();
+        }
+
+        // Clears the vector; the capacity (inline or heap) is kept.
+        void clear()
+        {
+            std::destroy_n(m_data, m_size);
+            m_size = 0;
+        }
+
+        // Swaps the content of this vector with another vector.
+        // Param: other - The vector to swap with.
+        void swap(SmallVector& other)
+        {
+            if (this == &other)
+                return;
+            SmallVector temp(std::move(other));
+            other.moveFrom(*this);
+            moveFrom(temp);
+        }
+
+        // Inserts a value at a specified index.
+        // Param: index - The index to insert at.
+        // Param: value - The value to insert.
+        void insert(size_t index, const T& value)
+        {
+            if (index > m_size)
+                return;
+            T copy(value);
+            if (m_size == m_capacity)
+                grow(nextCapacity());
+            if (index == m_size)
+            {
+                ::new (static_cast<void*>(m_data + m_size)) T(std::move(copy));
+            }
+            else
+            {
+                ::new (static_cast<void*>(m_data + m_size)) T(std::move(m_data[m_size - 1]));
+                for (size_t i = m_size - 1; i > index; --i)
+                    m_data[i] = std::move(m_data[i - 1]);
+                m_data[index] = std::move(copy);
+            }
+            ++m_size;
+        }
+
+        // Erases the element at a specific index.
+        // Param: index - The index to erase.
+        void erase(size_t index)
+        {
+            if (index >= m_size)
+                return;
+            for (size_t i = index; i < m_size - 1; ++i)
+                m_data[i] = std::move(m_data[i + 1]);
+            m_data[--m_size].~T();
+        }
+
+        // Resizes the vector to a new size, optionally expanding or shrinking.
+        // New elements are value-initialized.
+        // Param: newSize - The new size of the vector.
+        void resize(size_t newSize)
+        {
+            const size_t target = static_cast<size_t>(newSize);
+            if (target > m_capacity)
+                grow(target);
+            if (target < m_size)
+                std::destroy(m_data + target, m_data + m_size);
+            else
+                std::uninitialized_value_construct(m_data + m_size, m_data + target);
+            m_size = target;
+        }
+
+        // Reserves space for at least newCapacity elements.
+        // Param: newCapacity - The capacity to reserve.
+        void reserve(size_t newCapacity)
+        {
+            if (newCapacity > m_capacity)
+                grow(newCapacity);
+        }
+
+        // Returns the current number of elements in the vector.
+        // Returns: The size of the vector.
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        // Returns the largest number of elements the vector can address.
+        // Returns: The maximum size of the vector.
+        size_t max_size() const
+        {
+            return static_cast<size_t>(-1) / sizeof(T);
+        }
+
+        // Returns the current capacity of the vector (N while the elements are inline).
+        // Returns: The capacity of the vector.
+        size_t capacity() const
+        {
+            return m_capacity;
+        }
+
+        // Checks if the vector is empty.
+        // Returns: true if the vector is empty, false otherwise.
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        // Returns the memory resource used for heap storage (nullptr for the global heap).
+        std::pmr::memory_resource* resource() const
+        {
+            return m_resource;
+        }
+
+        // Checks if the elements are stored in the inline buffer.
+        // Returns: true if no heap storage is in use, false otherwise.
+        bool isInline() const
+        {
+            return m_data == inlineData();
+        }
+
+        // Returns a pointer to the underlying data array.
+        // Returns: A pointer to the vector's data.
+        T* data()
+        {
+            return m_data;
+        }
+
+        // Accesses an element at a specified index with bounds checking.
+        // Param: index - The index of the element.
+        // Returns: The element at the specified index.
+        T& at(size_t index)
+        {
+            detail::checkIndexAlways(index, m_size);
+            return m_data[index];
+        }
+
+        // Accesses an element at a specified index with bounds checking (const version).
+        // Param: index - The index of the element.
+        // Returns: The element at the specified index (const version).
+        const T& at(size_t index) const
+        {
+            detail::checkIndexAlways(index, m_size);
+            return m_data[index];
+        }
+
+        // Assigns a specific number of elements with the same value.
+        // Param: count - The number of elements to assign.
+        // Param: value - The value to assign to each element.
+        void assign(size_t count, const T& value)
+        {
+            T copy(value);
+            clear();
+            reserve(count);
+            std::uninitialized_fill_n(m_data, count, copy);
+            m_size = count;
+        }
+
+        // Returns the first element of the vector.
+        // Returns: The first element of the vector.
+        T& front()
+        {
+            return m_data[0];
+        }
+
+        // Returns the first element of the vector (const version).
+        // Returns: The first element of the vector (const version).
+        const T& front() const
+        {
+            return m_data[0];
+        }
+
+        // Returns the last element of the vector.
+        // Returns: The last element of the vector.
+        T& back()
+        {
+            return m_data[m_size - 1];
+        }
+
+        // Returns the last element of the vector (const version).
+        // Returns: The last element of the vector (const version).
+        const T& back() const
+        {
+            return m_data[m_size - 1];
+        }
+
+        // Accesses an element at a specified index.
+        // The index is only checked when MYLIB_BOUNDS_CHECK is enabled (debug builds).
+        // Param: index - The index of the element.
+        // Returns: The element at the specified index.
+        T& operator[](size_t index)
+        {
+            detail::checkIndex(index, m_size);
+            return m_data[index];
+        }
+
+        // Accesses an element at a specified index (const version).
+        // The index is only checked when MYLIB_BOUNDS_CHECK is enabled (debug builds).
+        // Param: index - The index of the element.
+        // Returns: The element at the specified index (const version).
+        const T& operator[](size_t index) const
+        {
+            detail::checkIndex(index, m_size);
+            return m_data[index];
+        }
+
+        // Compares this vector with another vector for equality.
+        // Param: other - The vector to compare with.
+        // Returns: true if both vectors are equal, false otherwise.
+        bool operator==(const SmallVector& other) const
+        {
+            if (m_size != other.m_size)
+                return false;
+            return bulk::equal(m_data, other.m_data, m_size);
+        }
+
+        // Compares this vector with another vector for inequality.
+        // Param: other - The vector to compare with.
+        // Returns: true if both vectors are not equal, false otherwise.
+        bool operator!=(const SmallVector& other) const
+        {
+            return !(*this == other);
+        }
+
+        // Compares this vector with another vector to check if it is less than.
+        // The vectors are ordered at the first position where their elements differ, found with SIMD compares.
+        // Param: other - The vector to compare with.
+        // Returns: true if this vector is less than the other, false otherwise.
+        bool operator<(const SmallVector& other) const
+        {
+            return simd::lexicographicLess(m_data, m_size, other.m_data, other.m_size);
+        }
+
+        // Less-than-or-equal-to operator for vector comparison.
+        // Param: other - The vector to compare to.
+        // Returns: true if the current vector is less than or equal to the other vector, false otherwise.
+        bool operator<=(const SmallVector& other) const
+        {
+            return !(other < *this);
+        }
+
+        // Greater-than operator for vector comparison.
+        // Param: other - The vector to compare to.
+        // Returns: true if the current vector is greater than the other vector, false otherwise.
+        bool operator>(const SmallVector& other) const
+        {
+            return other < *this;
+        }
+
+        // Greater-than-or-equal-to operator for vector comparison.
+        // Param: other - The vector to compare to.
+        // Returns: true if the current vector is greater than or equal to the other vector, false otherwise.
+        bool operator>=(const SmallVector& other) const
+        {
+            return !(*this < other);
+        }
+
+        // Addition assignment operator for vector addition.
+        // Param: other - The vector to add to the current vector.
+        // Returns: A reference to the updated vector after addition.
+        SmallVector& operator+=(const SmallVector& other)
+        {
+            for (size_t i = 0; i < m_size && i < other.m_size; ++i)
+                m_data[i] += other.m_data[i];
+            return *this;
+        }
+
+        // Subtraction assignment operator for vector subtraction.
+        // Param: other - The vector to subtract from the current vector.
+        // Returns: A reference to the updated vector after subtraction.
+        SmallVector& operator-=(const SmallVector& other)
+        {
+            for (size_t i = 0; i < m_size && i < other.m_size; ++i)
+                m_data[i] -= other.m_data[i];
+            return *this;
+        }
+
+        // Multiplication assignment operator for scalar multiplication.
+        // Param: scalar - The scalar value to multiply each element of the vector by.
+        // Returns: A reference to the updated vector after multiplication.
+        SmallVector& operator*=(const T& scalar)
+        {
+            for (size_t i = 0; i < m_size; ++i)
+                m_data[i] *= scalar;
+            return *this;
+        }
+
+        // Division assignment operator for scalar division.
+        // Param: scalar - The scalar value to divide each element of the vector by.
+        // Returns: A reference to the updated vector after division.
+        SmallVector& operator/=(const T& scalar)
+        {
+            for (size_t i = 0; i < m_size; ++i)
+                m_data[i] /= scalar;
+            return *this;
+        }
+
+        // Returns an iterator pointing to the first element of the container.
+        Iterator begin()
+        {
+            return Iterator(m_data);
+        }
+
+        // Returns an iterator pointing to the element after the last element.
+        Iterator end()
+        {
+            return Iterator(m_data + m_size);
+        }
+
+        // Returns a const iterator pointing to the first element of the container.
+        ConstIterator begin() const
+        {
+            return ConstIterator(m_data);
+        }
+
+        // Returns a const iterator pointing to the element after the last element.
+        ConstIterator end() const
+        {
+            return ConstIterator(m_data + m_size);
+        }
+
+        // Returns a reverse iterator pointing to the last element of the container.
+        ReverseIterator rbegin()
+        {
+            return ReverseIterator(m_data + m_size);
+        }
+
+        // Returns a reverse iterator marking the end of the reverse traversal (past the first element).
+        ReverseIterator rend()
+        {
+            return ReverseIterator(m_data);
+        }
+
+        // Returns a const reverse iterator pointing to the last element of the container.
+        ConstReverseIterator rbegin() const
+        {
+            return ConstReverseIterator(m_data + m_size);
+        }
+
+        // Returns a const reverse iterator marking the end of the reverse traversal (past the first element).
+        ConstReverseIterator rend() const
+        {
+            return ConstReverseIterator(m_data);
+        }
+
+    private:
+        T* m_data;         // Points at the inline buffer or at heap storage.
+        size_t m_size;     // Current size of the vector (number of elements).
+        size_t m_capacity; // N while inline, the heap allocation size otherwise.
+        std::pmr::memory_resource* m_resource; // Resource for heap storage, or nullptr for the global heap.
+        alignas(T) unsigned char m_inline[sizeof(T) * N]; // Raw inline storage for N elements.
+
+        // Computes the capacity for the next growth step: double the current one, clamped to max_size().
+        // Returns: The new capacity.
+        // Throws: std::bad_alloc if the vector is already at max_size().
+        size_t nextCapacity() const
+        {
+            if (m_capacity == 0)
+                return 1;
+            if (m_capacity >= max_size())
+                throw std::bad_alloc();
+            return m_capacity > max_size() / 2 ? max_size() : m_capacity * 2;
+        }
+
+        T* inlineData()
+        {
+            return reinterpret_cast<T*>(m_inline);
+        }
+
+        const T* inlineData() const
+        {
+            return reinterpret_cast<const T*>(m_inline);
+        }
+
+        // Moves the elements to a heap buffer of the given capacity.
+        // Param: newCapacity - The new capacity (larger than the current one).
+        void grow(size_t newCapacity)
+        {
+            T* newData = memory::allocateArray<T>(m_resource, newCapacity);
+            try
+            {
+                memory::relocate(m_data, m_size, newData);
+            }
+            catch (...)
+            {
+                memory::deallocateArray(m_resource, newData, newCapacity);
+                throw;
+            }
+            if (!isInline())
+                memory::deallocateArray(m_resource, m_data, m_capacity);
+            m_data = newData;
+            m_capacity = newCapacity;
+        }
+
+        // Destroys the elements, frees heap storage and returns to the inline buffer.
+        void release()
+        {
+            clear();
+            if (!isInline())
+                memory::deallocateArray(m_resource, m_data, m_capacity);
+            m_data = inlineData();
+            m_capacity = N;
+        }
+
+        // Copies the elements of other into this (empty) vector.
+        void copyFrom(const SmallVector& other)
+        {
+            reserve(other.m_size);
+            std::uninitialized_copy_n(other.m_data, other.m_size, m_data);
+            m_size = other.m_size;
+        }
+
+        // Takes the elements (and memory resource) of other, leaving it empty and inline.
+        // This vector must be empty and inline.
+        void moveFrom(SmallVector& other)
+        {
+            m_resource = other.m_resource;
+            if (other.isInline())
+            {
+                std::uninitialized_move_n(other.m_data, other.m_size, m_data);
+                m_size = other.m_size;
+                other.clear();
+            }
+            else
+            {
+                m_data = other.m_data;
+                m_size = other.m_size;
+                m_capacity = other.m_capacity;
+                other.m_data = other.inlineData();
+                other.m_size = 0;
+                other.m_capacity = N;
+            }
+        }
+    };
+
+} // namespace mylib
+
+#endif // MYLIB_SMALL_VECTOR_H
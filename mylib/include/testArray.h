@@ -1,7 +1,13 @@
 #ifndef TEST_ARRAY_H
 #define TEST_ARRAY_H
 
+#include <complex>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <string>
 
 #include "MyArray.h"
 #include "MyAlgo.h"
@@ -16,11 +22,17 @@ namespace mylib {
                 "     ----- '-'   ARRAY  TEST   '-' -----\n"
                 "     -----------------------------------\n";
             testResize();
+            testUninitialized();
+            testMemoryResource();
+            testHugePages();
+            testMapFile();
             testAssign();
             testClear();
             testFill();
+            testBulkOperations();
             testFrontBack();
             testSwap();
+            testBoundsCheck();
             testEquality();
             testIterators();
             testSelectionSort();
@@ -59,6 +71,158 @@ namespace mylib {
             std::cout << "\n" << std::endl;
         }
 
+        /*
+            Test the uninitialized allocation paths
+            Verifies that zeroing resizes zero only the new tail, uninitialized storage can be written,
+            and non-trivial elements survive a reallocating resize
+        */
+        static void testUninitialized()
+        {
+            Array<int> arr(3, uninitialized);
+            for (size_t i = 0; i < arr.getSize(); ++i)
+                arr[i] = static_cast<int>(i) + 1;
+            arr.resize(6);
+            std::cout << "testUninitialized: ";
+            for (size_t i = 0; i < arr.getSize(); ++i)
+                std::cout << arr[i] << " ";
+            arr.resize(2, uninitialized);
+            std::cout << "| shrunk: " << arr[0] << " " << arr[1];
+
+            Array<std::string> words(2);
+            words[0] = "kept";
+            words[1] = "across";
+            words.resize(4);
+            words[3] = "resize";
+            std::cout << " | strings: ";
+            for (size_t i = 0; i < words.getSize(); ++i)
+                std::cout << "[" << words[i] << "]";
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test allocation from a memory resource
+            Verifies that storage comes from the given resource, copies use the target's resource
+            and moves carry the resource with the storage
+        */
+        static void testMemoryResource()
+        {
+            struct CountingResource : std::pmr::memory_resource
+            {
+                size_t allocations = 0;
+                size_t liveBytes = 0;
+
+                void* do_allocate(size_t bytes, size_t alignment) override
+                {
+                    ++allocations;
+                    liveBytes += bytes;
+                    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+                }
+
+                void do_deallocate(void* p, size_t bytes, size_t alignment) override
+                {
+                    liveBytes -= bytes;
+                    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+                }
+
+                bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+                {
+                    return this == &other;
+                }
+            } counting;
+
+            std::cout << "testMemoryResource: ";
+            {
+                Array<int> arr(4, &counting);
+                arr.fill(7);
+                arr.resize(8);
+                Array<int> copy(arr);               // Global heap
+                Array<int> moved(std::move(arr));   // Keeps the resource
+                std::cout << "allocations: " << counting.allocations << ", live bytes: " << counting.liveBytes
+                          << ", moved keeps resource: " << (moved.resource() == &counting ? "yes" : "no")
+                          << ", copy on heap: " << (copy.resource() == nullptr ? "yes" : "no")
+                          << ", moved[3]: " << moved[3] << ", moved[7]: " << moved[7];
+            }
+            std::cout << ", live bytes after scope: " << counting.liveBytes;
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test huge-page backing of large arrays
+            Verifies that small arrays stay on the heap, large ones are mapped (huge pages when the system
+            allows it) and that data survives resizes across the threshold
+        */
+        static void testHugePages()
+        {
+            auto name = [](memory::PageBacking backing)
+            {
+                switch (backing)
+                {
+                case memory::PageBacking::HugeTlb: return "hugetlb";
+                case memory::PageBacking::TransparentHuge: return "transparent huge";
+                case memory::PageBacking::Mapped: return "mapped";
+                default: return "heap";
+                }
+            };
+
+            memory::resetHugePageStats();
+            Array<double> small(16);
+            Array<double> large(size_t(1) << 20);  // 8 MB
+            large[12345] = 2.5;
+            large.resize((size_t(3) << 20) / 2);
+            Array<double> shrunk(large);
+            shrunk.resize(1024);
+            memory::HugePageStats stats = memory::hugePageStats();
+
+            std::cout << "testHugePages: small: " << name(small.pageBacking())
+                      << ", large: " << (large.pageBacking() == memory::PageBacking::Heap ? "heap" : "large mapping")
+                      << ", shrunk: " << name(shrunk.pageBacking())
+                      << ", value kept: " << large[12345] << ", shrunk size: " << shrunk.getSize()
+                      << ", tail zeroed: " << large[large.getSize() - 1]
+                      << ", huge buffers: " << stats.hugeTlbBuffers + stats.transparentBuffers
+                      << " + fallback " << stats.fallbackBuffers << " (" << name(large.pageBacking()) << ")";
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test file-backed arrays
+            Verifies that a written file maps back read-only and copy-on-write, and that
+            copy-on-write changes never reach the file
+        */
+        static void testMapFile()
+        {
+            std::string path = (std::filesystem::temp_directory_path() / "mylib_test_array.bin").string();
+            Array<int> source(6);
+            for (size_t i = 0; i < source.getSize(); ++i)
+                source[i] = static_cast<int>(i * i);
+            source.writeToFile(path);
+
+            Array<int> readOnly = Array<int>::mapFile(path);
+            Array<int> copyOnWrite = Array<int>::mapFile(path, memory::FileMapping::CopyOnWrite);
+            copyOnWrite[0] = -1;
+            Array<int> reloaded = Array<int>::mapFile(path);
+
+            const Array<int>& view = readOnly;
+            std::cout << "testMapFile: read-only: ";
+            for (size_t i = 0; i < view.getSize(); ++i)
+                std::cout << view[i] << " ";
+            std::cout << "| copy-on-write [0]: " << copyOnWrite[0] << ", file [0]: " << reloaded[0]
+                      << ", read-only flag: " << (readOnly.isReadOnly() ? "yes" : "no");
+            readOnly.resize(7);  // Copies out of the mapping
+            readOnly[6] = 36;
+            std::cout << ", resized: " << readOnly[5] << " " << readOnly[6]
+                      << ", still read-only: " << (readOnly.isReadOnly() ? "yes" : "no");
+
+            Array<double>::mapFile(path).fill(1.0);  // Writes to a copy instead of faulting
+            Array<int> filled = Array<int>::mapFile(path);
+            filled.fill(7);
+            Array<int> written = Array<int>::mapFile(path);
+            written[1] = -5;
+            std::cout << ", filled: " << filled[0] << " " << filled[5] << ", written [1]: " << written[1]
+                      << ", file [1]: " << Array<int>::mapFile(path)[1];
+            std::remove(path.c_str());
+            std::cout << "\n" << std::endl;
+        }
+
         /*
             Test assigning values to the array
             Verifies that the array elements are properly assigned the specified value
@@ -108,6 +272,42 @@ namespace mylib {
             std::cout << "\n" << std::endl;
         }
 
+        /*
+            Test bulk fill, copy and comparison of large arrays
+            Verifies the multithreaded and non-temporal paths on an array past both thresholds,
+            including an odd-sized tail, a mismatch in the last element and a NaN (plain and inside std::complex) compared with itself
+        */
+        static void testBulkOperations()
+        {
+            const size_t count = bulk::kNonTemporalBytes / sizeof(int) + 3;
+            Array<int> source(count, uninitialized);
+            source.fill(0x01020304);
+            Array<int> copy(source);
+            bool equal = copy == source;
+            copy[count - 1] = 0;
+            bool differs = copy != source;
+            copy.fill(0);
+            source.assign(count, source[0] - 0x01020304);
+
+            Array<double> small(5);
+            small.fill(0.5);
+            Array<double> smallCopy(small);
+            smallCopy[2] = std::numeric_limits<double>::quiet_NaN();
+            const bool nanSelfEqual = bulk::equal(smallCopy.dataPointer(), smallCopy.dataPointer(), smallCopy.getSize());
+            const std::complex<double> complexNaN[] = { { 1.0, 0.0 }, { std::numeric_limits<double>::quiet_NaN(), 0.0 } };
+            const bool complexNaNSelfEqual = bulk::equal(complexNaN, complexNaN, 2);
+            smallCopy[2] = 0.5;
+
+            std::cout << "testBulkOperations: copy equal: " << (equal ? "yes" : "no")
+                      << ", last changed: " << (differs ? "differs" : "equal")
+                      << ", zeroed equal: " << (copy == source ? "yes" : "no")
+                      << ", small: " << smallCopy[0] << " " << smallCopy[4]
+                      << ", small equal: " << (small == smallCopy ? "yes" : "no")
+                      << ", NaN equals itself: " << (nanSelfEqual ? "yes" : "no")
+                      << ", complex NaN equals itself: " << (complexNaNSelfEqual ? "yes" : "no");
+            std::cout << "\n" << std::endl;
+        }
+
         /*
             Test front and back element access
             Verifies that front() and back() correctly return the first and last element of the array
@@ -151,6 +351,28 @@ namespace mylib {
             std::cout << "\n" << std::endl;
         }
 
+        /*
+            Test bounds checking of element access
+            Verifies that at() always rejects an invalid index and reports the active operator[] policy
+        */
+        static void testBoundsCheck()
+        {
+            Array<int> arr(3);
+            arr.at(2) = 5;
+            std::cout << "testBoundsCheck: ";
+            std::cout << "operator[] checked: " << (kBoundsCheck ? "yes" : "no") << ", at(2): " << arr.at(2);
+            try
+            {
+                arr.at(3);
+                std::cout << ", at(3): no exception";
+            }
+            catch (const char* error)
+            {
+                std::cout << ", at(3): " << error;
+            }
+            std::cout << "\n" << std::endl;
+        }
+
         /*
             Test equality operator for arrays
             Verifies that two arrays are correctly compared for equality
@@ -192,6 +414,9 @@ namespace mylib {
             std::cout << "testIterators: ";
             for (auto it = arr.begin(); it != arr.end(); ++it)
                 std::cout << *it << " ";
+            std::cout << "| reversed: ";
+            for (auto it = arr.rbegin(); it != arr.rend(); --it)
+                std::cout << *it << " ";
             std::cout << "\n" << std::endl;
         }
 
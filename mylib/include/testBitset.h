@@ -0,0 +1,161 @@
+#ifndef TEST_BITSET_H
+#define TEST_BITSET_H
+
+#include <iostream>
+#include "MyBitset.h"
+
+namespace mylib {
+    class testBitset {
+    public:
+        static void runTests()
+        {
+            std::cout <<
+                "     -----------------------------------\n"
+                "     ----- '-'   BITSET TEST   '-' -----\n"
+                "     -----------------------------------\n";
+
+            testPushBackAndAccess();
+            testRangeSetReset();
+            testBitwiseOperations();
+            testCountAndFind();
+            testLargeBitset();
+
+            std::cout <<
+                "     -----------------------------------\n"
+                "     ----- '-' ALL TEST PASSED '-' -----\n"
+                "     -----------------------------------\n\n\n";
+        }
+
+    private:
+        /*
+            Test push_back and element access
+            Verifies that bits are packed across word boundaries and can be read and written individually
+        */
+        static void testPushBackAndAccess()
+        {
+            DynamicBitset bits;
+            for (int i = 0; i < 70; ++i)
+                bits.push_back(i % 3 == 0);
+            bits[1] = true;
+            bits.flip(69);
+            bits.pop_back();
+
+            std::cout << "testPushBackAndAccess: ";
+            printBitset(bits);
+            std::cout << "size " << bits.size() << ", words " << bits.wordCount() << ", capacity " << bits.capacity();
+            try
+            {
+                bits.at(69);
+            }
+            catch (const char* e)
+            {
+                std::cout << ", exception caught: " << e;
+            }
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test range set and reset
+            Verifies that ranges inside one word and across several words only touch the requested bits
+        */
+        static void testRangeSetReset()
+        {
+            DynamicBitset bits(200);
+            bits.setRange(3, 7);
+            bits.setRange(60, 190);
+            bits.resetRange(64, 180);
+            bits.resize(210, true);
+
+            std::cout << "testRangeSetReset: count " << bits.count() << ", set bits:";
+            for (size_t i = bits.findFirst(); i < bits.size(); i = bits.findNext(i))
+                if (i < 70 || bits[i - 1] != bits[i])
+                    std::cout << " " << i;
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test bitwise operations
+            Verifies and, or, xor, difference and not, including the bits past the size staying clear
+        */
+        static void testBitwiseOperations()
+        {
+            DynamicBitset a(10), b(10);
+            a.setRange(0, 6);
+            b.setRange(4, 10);
+
+            std::cout << "testBitwiseOperations: a & b: ";
+            printBitset(a & b);
+            std::cout << "a | b: ";
+            printBitset(a | b);
+            std::cout << "a ^ b: ";
+            printBitset(a ^ b);
+            std::cout << "a - b: ";
+            printBitset(a - b);
+            std::cout << "~a: ";
+            printBitset(~a);
+            std::cout << "~a count: " << (~a).count() << ", ~~a == a: " << (~~a == a ? "yes" : "no");
+
+            try
+            {
+                a &= DynamicBitset(11);
+            }
+            catch (const char* e)
+            {
+                std::cout << ", exception caught: " << e;
+            }
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test count and find
+            Verifies popcount, any/none/all and iteration over set bits with findFirst/findNext
+        */
+        static void testCountAndFind()
+        {
+            DynamicBitset bits(1000);
+            for (size_t i = 0; i < bits.size(); i += 97)
+                bits.set(i);
+
+            std::cout << "testCountAndFind: count " << bits.count() << ", set bits:";
+            for (size_t i = bits.findFirst(); i < bits.size(); i = bits.findNext(i))
+                std::cout << " " << i;
+
+            DynamicBitset empty(300);
+            DynamicBitset full(300, true);
+            std::cout << " | empty: any " << empty.any() << ", none " << empty.none() << ", findFirst " << empty.findFirst()
+                << " | full: all " << full.all() << ", count " << full.count();
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test a large bitset
+            Verifies that the parallel word operations agree with the expected counts on 100M bits
+        */
+        static void testLargeBitset()
+        {
+            const size_t size = 100000000;
+            DynamicBitset evens(size);
+            for (size_t i = 0; i < size; i += 2)
+                evens[i] = true;
+            DynamicBitset low(size);
+            low.setRange(0, size / 2);
+
+            DynamicBitset both = evens & low;
+            DynamicBitset either = evens | low;
+            DynamicBitset odd = ~evens;
+            std::cout << "testLargeBitset: evens " << evens.count() << ", evens & low " << both.count()
+                << ", evens | low " << either.count() << ", odd " << odd.count()
+                << ", first odd " << odd.findFirst() << ", last set of low " << (low.findNext(size / 2 - 2));
+            std::cout << "\n" << std::endl;
+        }
+
+        static void printBitset(const DynamicBitset& bits)
+        {
+            for (size_t i = 0; i < bits.size(); ++i)
+                std::cout << (bits[i] ? '1' : '0');
+            std::cout << "\n";
+        }
+    };
+}
+
+#endif // TEST_BITSET_H
@@ -0,0 +1,185 @@
+#ifndef TEST_CONCURRENT_VECTOR_H
+#define TEST_CONCURRENT_VECTOR_H
+
+#include <atomic>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MyConcurrentVector.h"
+
+namespace mylib {
+    class testConcurrentVector {
+    public:
+        static void runTests()
+        {
+            std::cout <<
+                "     ----------------------------------------\n"
+                "     ----- '-' CONCURRENTVECTOR TEST '-' -----\n"
+                "     ----------------------------------------\n";
+
+            testPushBack();
+            testConcurrentPushBack();
+            testGrowBy();
+            testConcurrentReads();
+
+            std::cout <<
+                "     -----------------------------------\n"
+                "     ----- '-' ALL TEST PASSED '-' -----\n"
+                "     -----------------------------------\n\n\n";
+        }
+
+    private:
+        /*
+            Test single-threaded push_back
+            Verifies that indices are handed out in order and that growing never moves an element
+        */
+        static void testPushBack()
+        {
+            ConcurrentVector<std::string> vec;
+            vec.push_back("stable");
+            const std::string* first = &vec[0];
+            for (int i = 1; i < 1000; ++i)
+                vec.emplace_back(std::to_string(i));
+
+            std::cout << "testPushBack: size " << vec.size() << ", capacity " << vec.capacity()
+                << ", vec[999] = " << vec[999] << ", first element moved: " << (first == &vec[0] ? "no" : "yes");
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test concurrent push_back
+            Verifies that appends from several threads are neither lost nor duplicated, and that
+            threads racing into a new segment allocate it only once
+        */
+        static void testConcurrentPushBack()
+        {
+            struct CountingResource : std::pmr::memory_resource
+            {
+                std::atomic<size_t> allocations{ 0 };
+
+                void* do_allocate(size_t bytes, size_t alignment) override
+                {
+                    ++allocations;
+                    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+                }
+
+                void do_deallocate(void* p, size_t bytes, size_t alignment) override
+                {
+                    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+                }
+
+                bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+                {
+                    return this == &other;
+                }
+            } counting;
+
+            const int threads = 8;
+            const int perThread = 20000;
+            ConcurrentVector<int> vec(&counting);
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; ++t)
+                workers.emplace_back([&vec, t]() {
+                    for (int i = 0; i < perThread; ++i)
+                        vec.push_back(t * perThread + i);
+                });
+            for (std::thread& worker : workers)
+                worker.join();
+
+            std::vector<char> seen(threads * perThread, 0);
+            bool valid = vec.size() == seen.size();
+            for (size_t i = 0; valid && i < vec.size(); ++i)
+                valid = vec.published(i) && seen[vec[i]]++ == 0;
+
+            size_t segments = 0;
+            for (size_t covered = 0; covered < vec.capacity(); covered += ConcurrentVector<int>::firstSegmentSize << segments)
+                ++segments;
+
+            std::cout << "testConcurrentPushBack: size " << vec.size() << ", every value exactly once: " << (valid ? "yes" : "no")
+                << ", one allocation per segment: " << (counting.allocations == segments ? "yes" : "no");
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test grow_by
+            Verifies that grow_by reserves contiguous runs of indices, also when called from several threads,
+            and that a run too large to fit leaves the size unchanged
+        */
+        static void testGrowBy()
+        {
+            ConcurrentVector<int> vec(100);
+            size_t first = vec.grow_by(3, 7);
+            size_t next = vec.grow_by(2);
+            std::cout << "testGrowBy: ";
+            for (size_t i = 0; i < vec.size(); ++i)
+                std::cout << vec[i] << " ";
+            std::cout << "(runs start at " << first << " and " << next << ")\n";
+
+            ConcurrentVector<int> runs;
+            std::vector<std::thread> workers;
+            for (int t = 0; t < 4; ++t)
+                workers.emplace_back([&runs, t]() {
+                    for (int i = 0; i < 500; ++i)
+                    {
+                        size_t start = runs.grow_by(10, t);
+                        for (size_t j = start; j < start + 10; ++j)
+                            runs[j] = t;
+                    }
+                });
+            for (std::thread& worker : workers)
+                worker.join();
+
+            bool contiguous = runs.size() == 4 * 500 * 10;
+            for (size_t i = 0; contiguous && i < runs.size(); i += 10)
+                for (size_t j = i + 1; j < i + 10; ++j)
+                    contiguous = contiguous && runs[j] == runs[i];
+            std::cout << "concurrent runs contiguous: " << (contiguous ? "yes" : "no");
+
+            bool threw = false;
+            try
+            {
+                vec.grow_by(vec.max_size());
+            }
+            catch (const std::bad_alloc&)
+            {
+                threw = true;
+            }
+            std::cout << ", oversized run rejected: " << (threw ? "yes" : "no") << ", size still " << vec.size();
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test reads during appends
+            Verifies that a reader sees every published element with its final value while a writer appends
+        */
+        static void testConcurrentReads()
+        {
+            const size_t total = 50000;
+            ConcurrentVector<size_t> vec;
+            std::thread writer([&vec]() {
+                for (size_t i = 0; i < total; ++i)
+                    vec.push_back(i * 3);
+            });
+
+            bool consistent = true;
+            size_t checked = 0;
+            while (checked < total)
+            {
+                if (checked < vec.size() && vec.published(checked))
+                {
+                    consistent = consistent && vec[checked] == checked * 3;
+                    ++checked;
+                }
+            }
+            writer.join();
+
+            std::cout << "testConcurrentReads: checked " << checked << ", consistent: " << (consistent ? "yes" : "no");
+            std::cout << "\n" << std::endl;
+        }
+    };
+}
+
+#endif // TEST_CONCURRENT_VECTOR_H
@@ -2,6 +2,7 @@
 #define TEST_INTRUSIVE_LIST_H
 
 #include <iostream>
+#include <memory_resource>
 #include "MyIntrusiveList.h"
 
 namespace mylib {
@@ -35,6 +36,7 @@ namespace mylib {
             testAccessorsForDouble();
             testSizeForDouble();
             testEmptyForDouble();
+            testMemoryResource();
 
             std::cout <<
                 "     -----------------------------------\n"
@@ -347,6 +349,20 @@ namespace mylib {
             list.push_back(a);
             std::cout << "testEmpty after push_back (double): " << (list.empty() ? "Empty" : "Not Empty") << std::endl;
         }
+
+        // Test for allocating nodes from a memory resource
+        static void testMemoryResource()
+        {
+            std::pmr::monotonic_buffer_resource arena;
+            mylib::IntrusiveList<int> list(&arena);
+            for (int i = 0; i < 4; ++i)
+                list.push_back(i * 3);
+            mylib::IntrusiveList<int> copy(list, &arena);
+            copy.pop_front();
+
+            std::cout << "testMemoryResource: ";
+            copy.print();
+        }
     };
 }
 
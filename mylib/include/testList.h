@@ -2,6 +2,7 @@
 #define TEST_LIST_H
 
 #include <iostream>
+#include <memory_resource>
 #include "MyList.h"
 
 namespace mylib
@@ -30,6 +31,7 @@ namespace mylib
             testAccessors();
             testSize();
             testEmpty();
+            testMemoryResource();
 
             std::cout <<
                 "     -----------------------------------\n"
@@ -216,6 +218,25 @@ namespace mylib
             list.push_back(10);
             std::cout << "testEmpty after push_back: " << (list.empty() ? "Empty" : "Not Empty") << std::endl;
         }
+
+        // Test for allocating nodes from a memory resource, with copies and swaps
+        static void testMemoryResource()
+        {
+            std::pmr::monotonic_buffer_resource arena;
+            mylib::List<int> list(&arena);
+            list.push_back(1);
+            list.push_back(2);
+            list.push_front(0);
+
+            mylib::List<int> copy(list);
+            copy.push_back(3);
+            list.swap(copy);
+
+            std::cout << "testMemoryResource: ";
+            list.print();
+            std::cout << "testMemoryResource (swapped list on heap): " << (list.resource() == nullptr ? "yes" : "no")
+                      << ", other in arena: " << (copy.resource() == &arena ? "yes" : "no") << std::endl;
+        }
     };
 }
 #endif // TEST_LIST_H
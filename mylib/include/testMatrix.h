@@ -1,8 +1,20 @@
 #ifndef TEST_MATRIX_H
 #define TEST_MATRIX_H
 
+#include <algorithm>
+#include <complex>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "MyMatrix.h"
+#include "MyMatrixUpdate.h"
 #include "MyAlgo.h"
 
 namespace mylib {
@@ -21,11 +33,25 @@ namespace mylib {
             testAddition();
             testSubtraction();
             testMultiplication();
+            testBlockedMultiplication();
             testScalarMultiplication();
             testTranspose();
+            testLazyTranspose();
+            testConcurrentTransposeReads();
+            testCopyOnWrite();
             testDeterminant();
+            testIntegerDeterminant();
             testInverse();
+            testDerivedResultCache();
+            testLowRankUpdates();
             testEquality();
+            testHadamard();
+            testKron();
+            testColumnMajorLayout();
+            testColumnIterator();
+            testReductions();
+            testMemoryResource();
+            testMapFile();
             testMatrixSelectionSort();
             testMatrixColumnSelectionSort();
             testMatrixInsertionSort();
@@ -81,6 +107,53 @@ namespace mylib {
             std::cout << "testMultiplication: \n" << result << "\n" << std::endl;
         }
 
+        /*
+			Tests the cache-blocked product against a naive product, and GEMM
+			block-size tuning with a profile written to a temporary file, keeping
+			entries another process added to the file meanwhile.
+        */
+        static void testBlockedMultiplication()
+        {
+            const size_t n = 67;
+            Matrix<long long> mat1(n), mat2(n), expected(n);
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                {
+                    mat1(i, j) = static_cast<long long>((i * 7 + j) % 11) - 5;
+                    mat2(i, j) = static_cast<long long>((i + j * 3) % 13) - 6;
+                }
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    for (size_t k = 0; k < n; ++k)
+                        expected(i, j) += mat1(i, k) * mat2(k, j);
+
+            bool colMajorMatches = (mat1.toLayout<ColMajor>() * mat2.toLayout<ColMajor>()).toLayout<RowMajor>() == expected;
+
+            std::string profile = (std::filesystem::temp_directory_path() / "mylib_test_gemm.profile").string();
+            gemm::setProfilePath(profile);
+            GemmBlocking tuned = gemm::tune<long long>(48);
+            gemm::setProfilePath(profile);
+            GemmBlocking loaded = gemm::blocking<long long>();
+            bool persisted = loaded.rowBlock == tuned.rowBlock && loaded.depthBlock == tuned.depthBlock
+                && loaded.colBlock == tuned.colBlock;
+            bool tunedMatches = mat1 * mat2 == expected;
+
+            std::ofstream(profile, std::ios::app) << "other_process 8 8 8\n";
+            gemm::tune<short>(16);
+            std::ifstream saved(profile);
+            std::string line;
+            int keptEntries = 0;
+            while (std::getline(saved, line))
+                keptEntries += line.rfind("other_process ", 0) == 0 || line.rfind("long_long ", 0) == 0;
+            saved.close();
+            std::remove(profile.c_str());
+
+            std::cout << "testBlockedMultiplication: row-major " << (tunedMatches ? "matches" : "differs")
+                << ", column-major " << (colMajorMatches ? "matches" : "differs")
+                << ", tuned profile " << (persisted ? "persisted" : "lost")
+                << ", entries from other writers " << (keptEntries == 2 ? "kept" : "lost") << "\n" << std::endl;
+        }
+
         /*
 			Tests scalar multiplication on matrix.
         */
@@ -106,6 +179,98 @@ namespace mylib {
             std::cout << "testTranspose: \n" << result << "\n" << std::endl;
         }
 
+        /*
+			Tests that transposes are lazy views honored by the kernels.
+        */
+        static void testLazyTranspose()
+        {
+            Matrix<int> mat(3);
+            for (size_t i = 0; i < 3; ++i)
+                for (size_t j = 0; j < 3; ++j)
+                    mat(i, j) = static_cast<int>(i * 3 + j + 1);
+
+            Matrix<int> lazy = mat.transpose();
+            bool shared = lazy.sharesStorageWith(mat) && lazy.isTransposed();
+            Matrix<int> product = lazy * lazy;
+            Matrix<int> sum = lazy + mat;
+            bool viewMatches = lazy(0, 2) == mat(2, 0) && lazy.transpose() == mat;
+
+            std::cout << "testLazyTranspose: \n" << lazy << "shared " << (shared ? "yes" : "no")
+                << ", view " << (viewMatches ? "matches" : "differs") << "\nproduct:\n" << product
+                << "sum:\n" << sum << "storage: ";
+            for (const int* it = lazy.getBegin(); it != lazy.getEnd(); ++it)
+                std::cout << *it << " ";
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+			Tests const reads of a lazily transposed matrix from several threads: they
+			agree on one Layout-order copy and leave the shared storage alone.
+        */
+        static void testConcurrentTransposeReads()
+        {
+            const size_t n = 64;
+            Matrix<double> mat(n);
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    mat(i, j) = static_cast<double>(i * n + j);
+            const Matrix<double> lazy = mat.transpose();
+            const Matrix<double> expected = mat.transpose() * mat;
+
+            const int threads = 4;
+            std::vector<const double*> begins(threads);
+            std::vector<char> correct(threads);
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; ++t)
+                workers.emplace_back([&, t]() {
+                    begins[t] = lazy.getBegin();
+                    correct[t] = lazy * mat == expected && lazy.transpose() == mat && lazy.getBegin()[1] == static_cast<double>(n);
+                });
+            for (std::thread& worker : workers)
+                worker.join();
+
+            bool oneCopy = true;
+            bool allCorrect = true;
+            for (int t = 0; t < threads; ++t)
+            {
+                oneCopy = oneCopy && begins[t] == begins[0];
+                allCorrect = allCorrect && correct[t];
+            }
+            std::cout << "testConcurrentTransposeReads: one copy " << (oneCopy ? "yes" : "no")
+                << ", results correct " << (allCorrect ? "yes" : "no")
+                << ", still shared " << (lazy.sharesStorageWith(mat) && lazy.isTransposed() ? "yes" : "no") << "\n" << std::endl;
+        }
+
+        /*
+			Tests copy-on-write sharing of matrix storage, also for a matrix filled through
+			operator(), and that a reference taken again after a copy writes only the source.
+        */
+        static void testCopyOnWrite()
+        {
+            Matrix<double> original(2);
+            original.fill(1.0);
+            Matrix<double> copy = original;
+            bool sharedAfterCopy = copy.sharesStorageWith(original);
+
+            copy(0, 1) = 5.0;
+            bool sharedAfterWrite = copy.sharesStorageWith(original);
+
+            std::cout << "testCopyOnWrite: shared after copy " << (sharedAfterCopy ? "yes" : "no")
+                << ", after write " << (sharedAfterWrite ? "yes" : "no")
+                << ", original(0, 1) = " << original(0, 1) << ", copy(0, 1) = " << copy(0, 1) << "\n";
+
+            Matrix<double> source(2);
+            source(0, 0) = 1.0;
+            source(1, 1) = 2.0;
+            Matrix<double> filledCopy = source;
+            Matrix<double> transposed = source.transpose();
+            bool filledShared = filledCopy.sharesStorageWith(source) && transposed.sharesStorageWith(source);
+            double* data = source.begin();
+            data[0] = 7.0;
+            std::cout << "filled through operator(): copy and transpose shared " << (filledShared ? "yes" : "no")
+                << ", source(0, 0) = " << data[0] << ", copy(0, 0) = " << std::as_const(filledCopy)(0, 0) << "\n" << std::endl;
+        }
+
         /*
 			Tests matrix determinant calculation.
         */
@@ -118,6 +283,32 @@ namespace mylib {
             std::cout << "testDeterminant: " << mat.determinant() << "\n" << std::endl;
         }
 
+        /*
+			Tests exact integer determinants (Bareiss elimination).
+        */
+        static void testIntegerDeterminant()
+        {
+            Matrix<int> small(3);
+            small(0, 0) = 0; small(0, 1) = 2; small(0, 2) = 1;
+            small(1, 0) = 3; small(1, 1) = -1; small(1, 2) = 4;
+            small(2, 0) = 5; small(2, 1) = 6; small(2, 2) = -2;
+
+            const size_t n = 100;
+            Matrix<int> large(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                large(i, i) = 2;
+                if (i + 1 < n)
+                {
+                    large(i, i + 1) = -1;
+                    large(i + 1, i) = -1;
+                }
+            }
+
+            std::cout << "testIntegerDeterminant: " << small.determinant()
+                << " (expected 75), " << large.determinant() << " (expected 101)\n" << std::endl;
+        }
+
         /*
 			Tests matrix inversion.
         */
@@ -131,6 +322,147 @@ namespace mylib {
             std::cout << "testInverse: \n" << result << "\n" << std::endl;
         }
 
+        /*
+			Tests caching of determinant, LU factors and inverse across modifications,
+			including writes through a pointer taken again after a query, and queries
+			from several threads.
+        */
+        static void testDerivedResultCache()
+        {
+            Matrix<double> mat(3);
+            mat(0, 0) = 2; mat(0, 1) = 1; mat(0, 2) = 1;
+            mat(1, 0) = 4; mat(1, 1) = -6; mat(1, 2) = 0;
+            mat(2, 0) = -2; mat(2, 1) = 7; mat(2, 2) = 2;
+            const Matrix<double>& view = mat;
+
+            double first = view.determinant();
+            double second = view.determinant();
+            Matrix<double> inverse = view.inverse();
+            view.inverse();
+            mat(2, 2) = 3;
+            double modified = view.determinant();
+            Matrix<double> identity(3);
+            for (size_t i = 0; i < 3; ++i)
+                identity(i, i) = 1;
+            bool inverts = (mat * mat.inverse() - identity).frobeniusNorm() < 1e-9;
+
+            MatrixCacheStats stats = mat.cacheStats();
+            std::cout << "testDerivedResultCache: determinant " << first << "/" << second << ", after edit " << modified
+                << ", inverse(0, 0) " << inverse(0, 0) << ", A * inv(A) = I " << (inverts ? "yes" : "no")
+                << ", hits " << stats.hits << ", misses " << stats.misses << "\n";
+
+            Matrix<double> held(2);
+            double* p = held.begin();
+            p[0] = 1; p[1] = 2; p[2] = 3; p[3] = 4;
+            double before = held.determinant();
+            double repeated = held.determinant();
+            p = held.begin();
+            p[0] = 5;
+            double after = held.determinant();
+            std::cout << "through retaken pointer: determinant " << before << "/" << repeated << ", after write " << after
+                << ", hits " << held.cacheStats().hits << "\n";
+
+            Matrix<int> integral(2);
+            integral(0, 0) = 2; integral(1, 1) = 1;
+            std::as_const(integral).inverse();
+            std::cout << "integral inverse: misses " << integral.cacheStats().misses << " (expected 1)\n";
+
+            const Matrix<double> shared = mat;
+            std::vector<double> determinants(4);
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < determinants.size(); ++t)
+                workers.emplace_back([&, t]() {
+                    determinants[t] = shared.determinant() + shared.lu().determinant() + shared.inverse()(0, 0);
+                });
+            for (std::thread& worker : workers)
+                worker.join();
+            bool agree = std::all_of(determinants.begin(), determinants.end(), [&](double d) { return d == determinants[0]; });
+            std::cout << "concurrent queries agree " << (agree ? "yes" : "no") << "\n" << std::endl;
+        }
+
+        /*
+			Tests Sherman-Morrison/Woodbury inverse updates and rank-1 Cholesky/LU updates
+			against refactoring from scratch.
+        */
+        static void testLowRankUpdates()
+        {
+            const size_t n = 4;
+            Matrix<double> mat(n);
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    mat(i, j) = i == j ? 10.0 : 1.0 / static_cast<double>(i + j + 1);
+            auto distance = [](const Matrix<double>& a, const Matrix<double>& b) { return (a - b).frobeniusNorm(); };
+
+            // Change row 2 by delta and update the inverse.
+            Array<double> delta(n);
+            delta[0] = 0.5; delta[1] = -1.0; delta[2] = 2.0; delta[3] = 0.25;
+            Matrix<double> inverse = mat.inverse();
+            Matrix<double> changed = mat;
+            for (size_t j = 0; j < n; ++j)
+                changed(2, j) += delta[j];
+            updateInverseRow(inverse, 2, delta);
+            bool rowOk = distance(inverse, changed.inverse()) < 1e-9;
+
+            // Rank-2 Woodbury update.
+            Array<Array<double>> uColumns(2), vColumns(2);
+            for (size_t c = 0; c < 2; ++c)
+            {
+                uColumns[c] = Array<double>(n);
+                vColumns[c] = Array<double>(n);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    uColumns[c][i] = static_cast<double>(i + c + 1) * 0.1;
+                    vColumns[c][i] = static_cast<double>(n - i) * 0.2 - static_cast<double>(c);
+                }
+            }
+            Matrix<double> woodbury = mat.inverse();
+            Matrix<double> rankTwo = mat;
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    rankTwo(i, j) += uColumns[0][i] * vColumns[0][j] + uColumns[1][i] * vColumns[1][j];
+            woodburyUpdate(woodbury, uColumns, vColumns);
+            bool woodburyOk = distance(woodbury, rankTwo.inverse()) < 1e-9;
+
+            // Symmetric positive-definite Cholesky update then downdate.
+            Matrix<double> spd = mat + mat.transpose();
+            Matrix<double> factor = cholesky(spd);
+            Array<double> x(n);
+            x[0] = 1.0; x[1] = 0.5; x[2] = -0.5; x[3] = 2.0;
+            Matrix<double> spdUpdated = spd;
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    spdUpdated(i, j) += x[i] * x[j];
+            choleskyUpdate(factor, x);
+            bool choleskyOk = distance(factor * factor.transpose(), spdUpdated) < 1e-9;
+            choleskyDowndate(factor, x);
+            bool downdateOk = distance(factor, cholesky(spd)) < 1e-9;
+
+            // LU update checked through the determinant and a solve.
+            LUDecomposition<double> factors = mat.lu();
+            luUpdate(factors, delta, x);
+            Matrix<double> luTarget = mat;
+            for (size_t i = 0; i < n; ++i)
+                for (size_t j = 0; j < n; ++j)
+                    luTarget(i, j) += delta[i] * x[j];
+            Array<double> rhs(n);
+            rhs[0] = 1.0; rhs[3] = -1.0;
+            Array<double> solution(rhs);
+            factors.solveInPlace(solution.dataPointer());
+            double residual = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                double value = -rhs[i];
+                for (size_t j = 0; j < n; ++j)
+                    value += luTarget(i, j) * solution[j];
+                residual += value * value;
+            }
+            bool luOk = residual < 1e-18 && std::abs(factors.determinant() - luTarget.determinant()) < 1e-9;
+
+            std::cout << "testLowRankUpdates: row " << (rowOk ? "ok" : "wrong") << ", woodbury " << (woodburyOk ? "ok" : "wrong")
+                << ", cholesky update " << (choleskyOk ? "ok" : "wrong") << ", downdate " << (downdateOk ? "ok" : "wrong")
+                << ", lu update " << (luOk ? "ok" : "wrong") << "\n" << std::endl;
+        }
+
         /*
 			Tests equality operator for matrices.
         */
@@ -139,8 +471,191 @@ namespace mylib {
             Matrix<int> mat1(2), mat2(2);
             mat1.fill(1);
             mat2.fill(1);
+            Matrix<double> withNaN(2);
+            withNaN.fill(std::numeric_limits<double>::quiet_NaN());
+            Matrix<double> sharedNaN = withNaN;
+            Matrix<std::complex<double>> complexNaN(2);
+            complexNaN.fill({ std::numeric_limits<double>::quiet_NaN(), 0.0 });
+            Matrix<std::complex<double>> sharedComplexNaN = complexNaN;
+
+            std::cout << "testEquality: " << (mat1 == mat2 ? "Equal" : "Not Equal")
+                << ", NaN matrix vs its shared copy " << (withNaN == sharedNaN ? "Equal" : "Not Equal")
+                << ", complex NaN matrix vs its shared copy " << (complexNaN == sharedComplexNaN ? "Equal" : "Not Equal") << "\n" << std::endl;
+        }
+
+        /*
+			Tests elementwise (Hadamard) products, serial and multithreaded.
+        */
+        static void testHadamard()
+        {
+            Matrix<int> mat1(2), mat2(2);
+            mat1(0, 0) = 1; mat1(0, 1) = 2;
+            mat1(1, 0) = 3; mat1(1, 1) = 4;
+            mat2(0, 0) = 5; mat2(0, 1) = 6;
+            mat2(1, 0) = 7; mat2(1, 1) = 8;
+
+            Matrix<int> result = hadamard(mat1, mat2);
+            hadamardInPlace(mat1, mat2);
+
+            Matrix<double> big1(512), big2(512);
+            big1.fill(1.5);
+            big2.fill(-2.0);
+            bool parallelMatches = parallelHadamard(big1, big2) == hadamard(big1, big2);
+
+            std::cout << "testHadamard: \n" << result
+                << "in place " << (result == mat1 ? "matches" : "differs")
+                << ", parallel " << (parallelMatches ? "matches" : "differs") << "\n" << std::endl;
+        }
+
+        /*
+			Tests Kronecker products, serial and multithreaded.
+        */
+        static void testKron()
+        {
+            Matrix<int> mat1(2), mat2(2);
+            mat1(0, 0) = 1; mat1(0, 1) = 2;
+            mat1(1, 0) = 3; mat1(1, 1) = 4;
+            mat2(0, 0) = 0; mat2(0, 1) = 5;
+            mat2(1, 0) = 6; mat2(1, 1) = 7;
+
+            Matrix<int> result = kron(mat1, mat2);
+
+            Matrix<int> big1(16), big2(32);
+            for (size_t i = 0; i < 16; ++i)
+                for (size_t j = 0; j < 16; ++j)
+                    big1(i, j) = static_cast<int>(i * 16 + j);
+            big2.fill(3);
+            bool parallelMatches = parallelKron(big1, big2) == kron(big1, big2);
+
+            std::cout << "testKron: \n" << result
+                << "parallel " << (parallelMatches ? "matches" : "differs") << "\n" << std::endl;
+        }
+
+        /*
+			Tests the column-major layout policy and layout conversion.
+        */
+        static void testColumnMajorLayout()
+        {
+            Matrix<int> rowMajor(3);
+            for (size_t i = 0; i < 3; ++i)
+                for (size_t j = 0; j < 3; ++j)
+                    rowMajor(i, j) = static_cast<int>(i * 3 + j);
+
+            Matrix<int, ColMajor> colMajor = rowMajor.toLayout<ColMajor>();
+            bool roundTrip = colMajor.toLayout<RowMajor>() == rowMajor;
 
-            std::cout << "testEquality: " << (mat1 == mat2 ? "Equal" : "Not Equal") << "\n" << std::endl;
+            std::cout << "testColumnMajorLayout: \n" << colMajor << "column 1: ";
+            for (auto it = colMajor.colBegin(1); it != colMajor.colEnd(1); ++it)
+                std::cout << *it << " ";
+            std::cout << "\nstorage: ";
+            for (const int* it = colMajor.getBegin(); it != colMajor.getEnd(); ++it)
+                std::cout << *it << " ";
+            std::cout << "\ndeterminant " << (colMajor * colMajor).transpose().determinant()
+                << ", round trip " << (roundTrip ? "matches" : "differs") << "\n" << std::endl;
+        }
+
+        /*
+			Tests the random-access column iterator with the standard algorithms.
+        */
+        static void testColumnIterator()
+        {
+            static_assert(std::random_access_iterator<Matrix<int>::ColumnIterator>);
+            static_assert(std::contiguous_iterator<decltype(Matrix<int>(1).begin())>);
+
+            Matrix<int> matrix(3);
+            const int values[] = { 5, 7, 4, 9, 3, 8, 2, 1, 6 };
+            std::copy(values, values + 9, matrix.begin());
+            std::sort(matrix.colBegin(1), matrix.colEnd(1));
+            auto found = std::lower_bound(matrix.colBegin(1), matrix.colEnd(1), 7);
+
+            std::cout << "testColumnIterator: sorted column 1: ";
+            for (auto it = matrix.colBegin(1); it != matrix.colEnd(1); ++it)
+                std::cout << *it << " ";
+            std::cout << "| lower_bound(7) at row " << (found - matrix.colBegin(1))
+                      << ", column length " << std::distance(matrix.colBegin(1), matrix.colEnd(1))
+                      << ", last via [] " << matrix.colBegin(1)[2] << "\n" << std::endl;
+        }
+
+        /*
+			Tests matrix reductions: sum, min/max, argmin/argmax, norms and trace.
+        */
+        static void testReductions()
+        {
+            Matrix<int> mat(3);
+            mat(0, 0) = 1; mat(0, 1) = -7; mat(0, 2) = 3;
+            mat(1, 0) = 4; mat(1, 1) = 5; mat(1, 2) = -6;
+            mat(2, 0) = 2; mat(2, 1) = 8; mat(2, 2) = 0;
+            Matrix<int, ColMajor> colMajor = mat.toLayout<ColMajor>();
+
+            std::pair<size_t, size_t> minPos = mat.argmin();
+            std::pair<size_t, size_t> maxPos = colMajor.argmax();
+            std::cout << "testReductions: sum " << mat.sum() << ", min " << mat.min() << ", max " << mat.max()
+                << ", argmin (" << minPos.first << ", " << minPos.second << ")"
+                << ", argmax (" << maxPos.first << ", " << maxPos.second << ")"
+                << ", trace " << mat.trace() << ", norm1 " << mat.norm1() << "/" << colMajor.norm1()
+                << ", normInf " << mat.normInf() << "/" << colMajor.normInf() << "\n";
+
+            Matrix<double> large(1024);
+            large.fill(0.5);
+            large(1000, 3) = -4.0;
+            std::pair<size_t, size_t> largeMin = large.argmin();
+            std::cout << "large: sum " << large.sum() << ", frobenius " << large.frobeniusNorm()
+                << ", argmin (" << largeMin.first << ", " << largeMin.second << ")"
+                << ", norm1 " << large.norm1() << ", normInf " << large.normInf() << "\n" << std::endl;
+        }
+
+        /*
+			Tests matrices allocated from a memory resource: results and copy-on-write
+			detaches stay in the same resource.
+        */
+        static void testMemoryResource()
+        {
+            std::pmr::monotonic_buffer_resource arena;
+            Matrix<double> a(3, &arena);
+            for (size_t i = 0; i < 3; ++i)
+                a(i, i) = 2.0;
+            Matrix<double> shared = a;
+            shared(0, 1) = 1.0;
+            Matrix<double> product = a * shared;
+            Matrix<double> transposed = product.transpose();
+
+            std::cout << "testMemoryResource: product in arena " << (product.resource() == &arena ? "yes" : "no")
+                << ", detached copy in arena " << (shared.resource() == &arena ? "yes" : "no")
+                << ", transpose in arena " << (transposed.resource() == &arena ? "yes" : "no") << "\n"
+                << transposed << std::endl;
+        }
+
+        /*
+			Tests file-backed matrices: a read-only mapping detaches to regular storage on the first write,
+			and a lazily transposed matrix is written in its logical order.
+        */
+        static void testMapFile()
+        {
+            std::string path = (std::filesystem::temp_directory_path() / "mylib_test_matrix.bin").string();
+            Matrix<double> mat(2);
+            mat(0, 0) = 1.0; mat(0, 1) = 2.0;
+            mat(1, 0) = 3.0; mat(1, 1) = 4.0;
+            mat.transpose().writeToFile(path);
+
+            Matrix<double> mapped = Matrix<double>::mapFile(path);
+            bool fileBacked = mapped.pageBacking() == memory::PageBacking::FileReadOnly;
+            mapped(1, 1) = 40.0;
+            std::cout << "testMapFile: file-backed " << (fileBacked ? "yes" : "no")
+                << ", after write " << (mapped.pageBacking() == memory::PageBacking::FileReadOnly ? "file-backed" : "detached")
+                << ", determinant of file " << Matrix<double>::mapFile(path).determinant() << "\n" << mapped;
+
+            Array<double> odd(3);
+            odd.writeToFile(path);
+            try
+            {
+                Matrix<double>::mapFile(path);
+            }
+            catch (const char* error)
+            {
+                std::cout << "3 elements: " << error << "\n";
+            }
+            std::remove(path.c_str());
+            std::cout << std::endl;
         }
 
         /*
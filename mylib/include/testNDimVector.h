@@ -1,7 +1,11 @@
 #ifndef TEST_NDIMVECTOR_H
 #define TEST_NDIMVECTOR_H
 
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
+#include <string>
 #include "MyNDimVector.h"
 
 namespace mylib
@@ -20,12 +24,14 @@ namespace mylib
             testCrossProduct();
             testNorm();
             testNormalize();
+            testReductions();
             testAddition();
             testSubtraction();
             testScalarMultiplication();
             testScalarDivision();
             testReverse();
             testProjection();
+            testMapFile();
             /*testIterator();   failed */
             testSelectionSort();
             testInsertionSort();
@@ -84,6 +90,57 @@ namespace mylib
             std::cout << std::endl;
         }
 
+        // Tests that writing to a read-only mapped vector copies it out instead of faulting
+        static void testMapFile()
+    	{
+            std::string path = (std::filesystem::temp_directory_path() / "mylib_test_vector_nd.bin").string();
+            VectorND<double>({ 3, 4, 12 }).writeToFile(path);
+
+            VectorND<double> vec = VectorND<double>::mapFile(path);
+            vec.normalize();
+            VectorND<double> file = VectorND<double>::mapFile(path);
+
+            std::cout << "testMapFile: ";
+            for (size_t i = 0; i < vec.size(); ++i)
+                std::cout << vec[i] << " ";
+            std::cout << "| file: " << file[0] << " " << file[1] << " " << file[2] << std::endl;
+            std::remove(path.c_str());
+        }
+
+        // Tests sum, min/max, argmin/argmax and the 1/infinity norms, on a small and a large vector
+        static void testReductions()
+    	{
+            VectorND<int> vec({ 4, -9, 2, 7, -1 });
+
+            VectorND<double> large(1 << 20);
+            for (size_t i = 0; i < large.size(); ++i)
+                large[i] = static_cast<double>(i % 1000) - 500.0;
+            large[123457] = 1e6;
+
+            std::cout << "testReductions: sum " << vec.sum() << ", min " << vec.min() << ", max " << vec.max()
+                << ", argmin " << vec.argmin() << ", argmax " << vec.argmax()
+                << ", norm1 " << vec.norm1() << ", normInf " << vec.normInf() << std::endl;
+            std::cout << "testReductions (large): argmax " << large.argmax() << ", max " << large.max()
+                << ", min " << large.min() << ", sum " << large.sum() << std::endl;
+
+            // Chunk partials are combined in chunk order, so rounding is the same on every run
+            for (size_t i = 0; i < large.size(); ++i)
+                large[i] = 1.0 / static_cast<double>(i + 1);
+            const double first = large.sum();
+            bool repeatable = true;
+            for (int run = 0; run < 20; ++run)
+                repeatable = repeatable && large.sum() == first && large.norm() == large.norm();
+            std::cout << "testReductions (repeated): sums identical " << (repeatable ? "yes" : "no") << std::endl;
+
+            // NaN propagates the same way through the SIMD kernels, the scalar tails and the chunk merge
+            VectorND<double> small({ 2.0, -1.0, std::nan(""), 5.0, -4.0 });
+            large[700000] = std::nan("");
+            large[900000] = std::nan("");
+            std::cout << "testReductions (NaN): small min " << small.min() << " at " << small.argmin()
+                << ", max " << small.max() << " at " << small.argmax()
+                << ", large min " << large.min() << " at " << large.argmin() << ", argmax " << large.argmax() << std::endl;
+        }
+
         // Tests the addition of two vectors
         static void testAddition()
     	{
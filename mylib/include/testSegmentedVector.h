@@ -0,0 +1,190 @@
+#ifndef TEST_SEGMENTED_VECTOR_H
+#define TEST_SEGMENTED_VECTOR_H
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include "MySegmentedVector.h"
+
+namespace mylib {
+    class testSegmentedVector {
+    public:
+        static void runTests()
+        {
+            std::cout <<
+                "     ----------------------------------------\n"
+                "     ----- '-' SEGMENTEDVECTOR TEST '-' -----\n"
+                "     ----------------------------------------\n";
+
+            testPushBothEnds();
+            testPopBothEnds();
+            testStableAddresses();
+            testInsertErase();
+            testIterators();
+            testCopyAndMove();
+
+            std::cout <<
+                "     -----------------------------------\n"
+                "     ----- '-' ALL TEST PASSED '-' -----\n"
+                "     -----------------------------------\n\n\n";
+        }
+
+    private:
+        /*
+            Test push_back and push_front
+            Verifies that elements added at both ends keep their order across block boundaries
+        */
+        static void testPushBothEnds()
+        {
+            SegmentedVector<int> vec;
+            for (int i = 0; i < 5; ++i)
+            {
+                vec.push_back(i);
+                vec.push_front(-i - 1);
+            }
+
+            std::cout << "testPushBothEnds: ";
+            printVector(vec);
+
+            SegmentedVector<long long> big;
+            const int count = 10000;
+            for (int i = 0; i < count; ++i)
+            {
+                big.push_back(i);
+                big.push_front(-i - 1);
+            }
+            bool ordered = big.size() == 2 * count;
+            for (size_t i = 0; ordered && i < big.size(); ++i)
+                ordered = big[i] == static_cast<long long>(i) - count;
+            std::cout << "20000 elements in " << big.blockCount() << " blocks of " << big.blockSize
+                << ", ordered: " << (ordered ? "yes" : "no");
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test pop_back and pop_front
+            Verifies that blocks are released as the vector drains from either end and that it can be refilled
+        */
+        static void testPopBothEnds()
+        {
+            SegmentedVector<int> vec;
+            for (int i = 0; i < 3000; ++i)
+                vec.push_back(i);
+            for (int i = 0; i < 1000; ++i)
+            {
+                vec.pop_front();
+                vec.pop_back();
+            }
+            std::cout << "testPopBothEnds: size " << vec.size() << ", front " << vec.front() << ", back " << vec.back()
+                << ", blocks " << vec.blockCount() << "\n";
+
+            while (!vec.empty())
+                vec.pop_front();
+            vec.push_front(7);
+            vec.push_back(8);
+            std::cout << "refilled: ";
+            printVector(vec);
+            std::cout << std::endl;
+        }
+
+        /*
+            Test address stability
+            Verifies that references taken early stay valid while the vector grows at both ends
+        */
+        static void testStableAddresses()
+        {
+            SegmentedVector<std::string> words;
+            words.push_back("anchor");
+            const std::string* anchor = &words[0];
+            for (int i = 0; i < 5000; ++i)
+            {
+                words.emplace_back(std::to_string(i));
+                words.emplace_front(std::to_string(-i));
+            }
+
+            std::cout << "testStableAddresses: size " << words.size() << ", anchor moved: "
+                << (anchor == &words[5000] ? "no" : "yes") << ", anchor value: " << *anchor;
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test insert and erase
+            Verifies that elements shift correctly around the inserted and erased positions
+        */
+        static void testInsertErase()
+        {
+            SegmentedVector<int> vec;
+            vec.push_back(1);
+            vec.push_back(3);
+            vec.insert(1, 2);
+            vec.insert(3, 4);
+            vec.push_front(0);
+            vec.erase(2);
+
+            std::cout << "testInsertErase: ";
+            printVector(vec);
+            try
+            {
+                vec.at(10);
+            }
+            catch (const char* e)
+            {
+                std::cout << "Exception caught: " << e << "\n";
+            }
+            std::cout << std::endl;
+        }
+
+        /*
+            Test iterators
+            Verifies that the random-access iterators work with the standard algorithms across blocks
+        */
+        static void testIterators()
+        {
+            SegmentedVector<int> vec;
+            for (int i = 0; i < 2000; ++i)
+                vec.push_front((i * 7919) % 2000);
+            std::sort(vec.begin(), vec.end());
+
+            const SegmentedVector<int>& view = vec;
+            bool sorted = std::is_sorted(view.begin(), view.end());
+            SegmentedVector<int>::ConstIterator found = std::lower_bound(view.begin(), view.end(), 1234);
+
+            std::cout << "testIterators: sorted " << (sorted ? "yes" : "no") << ", lower_bound(1234) at "
+                << (found - view.begin()) << ", distance " << (view.end() - view.begin());
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test copy, move and comparison
+            Verifies that copies are independent and that moves take over the blocks
+        */
+        static void testCopyAndMove()
+        {
+            SegmentedVector<int> vec;
+            for (int i = 0; i < 600; ++i)
+                vec.push_front(i);
+
+            SegmentedVector<int> copy = vec;
+            copy.back() = -1;
+            SegmentedVector<int> moved = std::move(vec);
+
+            std::cout << "testCopyAndMove: copy equal: " << (copy == moved ? "yes" : "no")
+                << ", copy less: " << (copy < moved ? "yes" : "no")
+                << ", moved-from empty: " << (vec.empty() ? "yes" : "no");
+            copy = moved;
+            std::cout << ", equal after assignment: " << (copy == moved ? "yes" : "no");
+            copy.shrink_to_fit();
+            std::cout << ", blocks after shrink: " << copy.blockCount();
+            std::cout << "\n" << std::endl;
+        }
+
+        static void printVector(const SegmentedVector<int>& vec)
+        {
+            for (size_t i = 0; i < vec.size(); ++i)
+                std::cout << vec[i] << " ";
+            std::cout << "\n";
+        }
+    };
+}
+
+#endif // TEST_SEGMENTED_VECTOR_H
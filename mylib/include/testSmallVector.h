@@ -0,0 +1,139 @@
+#ifndef TEST_SMALL_VECTOR_H
+#define TEST_SMALL_VECTOR_H
+
+#include <iostream>
+#include <string>
+#include "MySmallVector.h"
+
+namespace mylib {
+    class testSmallVector {
+    public:
+        static void runTests()
+        {
+            std::cout <<
+                "     -----------------------------------\n"
+                "     ----- '-' SMALLVECTOR TEST '-' -----\n"
+                "     -----------------------------------\n";
+
+            testInlineStorage();
+            testSpillToHeap();
+            testInsertErase();
+            testCopyAndSwap();
+            testNonTrivialElements();
+
+            std::cout <<
+                "     -----------------------------------\n"
+                "     ----- '-' ALL TEST PASSED '-' -----\n"
+                "     -----------------------------------\n\n\n";
+        }
+
+    private:
+        /*
+            Test inline storage
+            Verifies that up to N elements are stored without leaving the inline buffer
+        */
+        static void testInlineStorage()
+        {
+            SmallVector<int, 4> vec;
+            for (int i = 1; i <= 4; ++i)
+                vec.push_back(i * 10);
+
+            std::cout << "testInlineStorage: ";
+            printVector(vec);
+            std::cout << "inline: " << (vec.isInline() ? "yes" : "no") << ", capacity: " << vec.capacity();
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test growing past the inline capacity
+            Verifies that the elements move to the heap intact once N is exceeded
+        */
+        static void testSpillToHeap()
+        {
+            SmallVector<int, 4> vec;
+            for (int i = 1; i <= 6; ++i)
+                vec.push_back(i);
+            vec.push_back(vec[0]); // Aliases an element while reallocating
+
+            std::cout << "testSpillToHeap: ";
+            printVector(vec);
+            std::cout << "inline: " << (vec.isInline() ? "yes" : "no") << ", capacity: " << vec.capacity();
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test insert and erase
+            Verifies that elements shift correctly around the inserted and erased positions
+        */
+        static void testInsertErase()
+        {
+            SmallVector<int, 3> vec;
+            vec.push_back(1);
+            vec.push_back(3);
+            vec.insert(1, 2);
+            vec.insert(3, 4); // Spills to the heap
+            vec.erase(0);
+
+            std::cout << "testInsertErase: ";
+            printVector(vec);
+            std::cout << std::endl;
+        }
+
+        /*
+            Test copy, move and swap
+            Verifies that inline and heap vectors can be copied, moved and swapped with each other
+        */
+        static void testCopyAndSwap()
+        {
+            SmallVector<int, 2> small;
+            small.push_back(-1);
+            SmallVector<int, 2> large;
+            for (int i = 0; i < 5; ++i)
+                large.push_back(i);
+
+            SmallVector<int, 2> copy = large;
+            SmallVector<int, 2> moved = static_cast<SmallVector<int, 2>&&>(copy);
+            small.swap(large);
+
+            std::cout << "testCopyAndSwap (moved): ";
+            printVector(moved);
+            std::cout << "testCopyAndSwap (swapped small): ";
+            printVector(small);
+            std::cout << "testCopyAndSwap (swapped large): ";
+            printVector(large);
+            std::cout << "equal after move: " << (moved == small ? "yes" : "no");
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test non-trivial elements
+            Verifies that elements with owning members are constructed and destroyed correctly across a spill
+        */
+        static void testNonTrivialElements()
+        {
+            SmallVector<std::string, 2> words;
+            words.push_back("small");
+            words.push_back("buffer");
+            words.push_back("optimization");
+            words.resize(4);
+            words.back() = "works";
+            words.pop_back();
+
+            std::cout << "testNonTrivialElements: ";
+            for (unsigned int i = 0; i < words.size(); ++i)
+                std::cout << words[i] << " ";
+            std::cout << "\n" << std::endl;
+        }
+
+        // Utility function to print a small vector
+        template <unsigned int N>
+        static void printVector(const SmallVector<int, N>& vec)
+        {
+            for (unsigned int i = 0; i < vec.size(); ++i)
+                std::cout << vec[i] << " ";
+            std::cout << std::endl;
+        }
+    };
+}
+
+#endif // TEST_SMALL_VECTOR_H
@@ -1,7 +1,15 @@
 #ifndef TEST_VECTOR_H
 #define TEST_VECTOR_H
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <memory_resource>
+#include <new>
+#include <sstream>
+#include <string>
 #include "MyVector.h"
 #include "MyAlgo.h"
 
@@ -16,16 +24,24 @@ namespace mylib {
                 "     -----------------------------------\n";
 
             testPushBack();
+            testEmplaceBack();
             testPopBack();
             testInsert();
             testErase();
+            testRangeInsertErase();
             testResize();
             testReserve();
             testEquality();
+            testComparison();
             testAssign();
             testCapacity();
+            testLargeSizes();
+            testGrowthPolicy();
+            testIncrementalGrowth();
             testAccessors();
             testCopyAndMove();
+            testMemoryResource();
+            testStdAlgorithms();
             testSelectionSort();
             testInsertionSort();
             testBubbleSort();
@@ -105,6 +121,51 @@ namespace mylib {
             std::cout << std::endl;
         }
 
+        /*
+            Test range insert and erase, erase_if and swap_erase
+            Verifies ranges inserted before, inside and past the shifted tail (with and without
+            reallocation, for trivial and non-trivial elements), single-pass input ranges, and
+            the order kept or dropped by the different erasures
+        */
+        static void testRangeInsertErase()
+        {
+            Vector<int> vec;
+            for (int i = 0; i < 6; ++i)
+                vec.push_back(i);
+            const int values[] = { 100, 101, 102 };
+            vec.insert(2, values, values + 3);
+            std::istringstream input("7 8");
+            vec.insert(0, std::istream_iterator<int>(input), std::istream_iterator<int>());
+            vec.erase(1, 3);
+            std::cout << "testRangeInsertErase: ";
+            for (size_t i = 0; i < vec.size(); ++i)
+                std::cout << vec[i] << " ";
+
+            size_t removed = vec.erase_if([](int value) { return value % 2 == 0; });
+            std::cout << "| erase_if removed " << removed << ": ";
+            for (size_t i = 0; i < vec.size(); ++i)
+                std::cout << vec[i] << " ";
+            vec.swap_erase(0);
+            std::cout << "| swap_erase(0): ";
+            for (size_t i = 0; i < vec.size(); ++i)
+                std::cout << vec[i] << " ";
+
+            Vector<std::string> words;
+            words.reserve(8);
+            words.push_back("a");
+            words.push_back("b");
+            words.push_back("c");
+            const std::string few[] = { "x" };
+            const std::string many[] = { "p", "q", "r" };
+            words.insert(1, few, few + 1);   // Fewer than the tail
+            words.insert(3, many, many + 3); // More than the tail
+            words.erase(0, 2);
+            std::cout << "| strings: ";
+            for (size_t i = 0; i < words.size(); ++i)
+                std::cout << words[i] << " ";
+            std::cout << "\n" << std::endl;
+        }
+
         /*
             Test resize functionality
             Verifies that the vector can be resized properly and maintains its data
@@ -137,6 +198,39 @@ namespace mylib {
             std::cout << std::endl;
         }
 
+        /*
+            Test emplace_back, moving push_back and relocation on growth
+            Verifies that elements are built in place, that rvalues are moved from, that growth
+            relocates strings without copying their buffers and that an argument referring
+            into the vector survives the reallocation
+        */
+        static void testEmplaceBack()
+        {
+            Vector<std::string> vec;
+            vec.emplace_back(20, 'a');
+            std::string moved(20, 'b');
+            vec.push_back(std::move(moved));
+            const char* buffer = vec[0].data();
+            for (int i = 0; i < 100; ++i)
+                vec.emplace_back("filler");
+            vec.push_back(vec[0]);  // Aliases an element while the vector is full
+
+            Vector<Vector<int>> nested;
+            for (int i = 0; i < 10; ++i)
+            {
+                Vector<int> inner;
+                inner.push_back(i);
+                nested.push_back(std::move(inner));
+            }
+
+            std::cout << "testEmplaceBack: size: " << vec.size() << ", first: " << vec[0]
+                      << ", moved-from empty: " << (moved.empty() ? "yes" : "no")
+                      << ", buffer kept on growth: " << (vec[0].data() == buffer ? "yes" : "no")
+                      << ", aliased copy: " << vec.back()
+                      << ", nested: " << nested[0][0] << " " << nested[9][0];
+            std::cout << "\n" << std::endl;
+        }
+
         /*
             Test equality operator
             Verifies that two vectors with the same data are considered equal
@@ -154,6 +248,45 @@ namespace mylib {
             std::cout << "\n" << std::endl;
         }
 
+        /*
+            Test lexicographic comparison and IEEE equality
+            Verifies that a difference past the first SIMD block decides the order, that NaN never
+            compares equal and that -0.0 equals 0.0
+        */
+        static void testComparison()
+        {
+            Vector<int> a, b;
+            for (int i = 0; i < 37; ++i)
+            {
+                a.push_back(i);
+                b.push_back(i);
+            }
+            b[33] = 100;
+            Vector<int> prefix;
+            prefix.push_back(0);
+            prefix.push_back(1);
+
+            Vector<double> x, y;
+            for (int i = 0; i < 9; ++i)
+            {
+                x.push_back(i * 0.5);
+                y.push_back(i * 0.5);
+            }
+            x[0] = -0.0;
+            bool zeroEqual = x == y;
+            x[6] = y[6] = std::numeric_limits<double>::quiet_NaN();
+            bool nanEqual = x == y;
+            y[8] = 5.0;
+
+            std::cout << "testComparison: a < b: " << (a < b ? "yes" : "no")
+                      << ", b > a: " << (b > a ? "yes" : "no")
+                      << ", prefix < a: " << (prefix < a ? "yes" : "no")
+                      << ", -0.0 == 0.0: " << (zeroEqual ? "yes" : "no")
+                      << ", NaN == NaN: " << (nanEqual ? "yes" : "no")
+                      << ", x < y past NaN: " << (x < y ? "yes" : "no");
+            std::cout << "\n" << std::endl;
+        }
+
         /*
             Test assign functionality
             Verifies that the vector can be filled with specific values using assign
@@ -182,6 +315,138 @@ namespace mylib {
             std::cout << std::endl;
         }
 
+        /*
+            Test 64-bit sizing
+            Verifies that sizes past 32 bits are representable and that a request beyond
+            max_size() is rejected with std::bad_alloc instead of being truncated
+        */
+        static void testLargeSizes()
+        {
+            Vector<int> vec;
+            bool rejected = false;
+            try
+            {
+                vec.reserve(vec.max_size() + 1);
+            }
+            catch (const std::bad_alloc&)
+            {
+                rejected = true;
+            }
+            std::cout << "testLargeSizes: max_size past 32 bits: "
+                      << (vec.max_size() > std::numeric_limits<unsigned int>::max() ? "yes" : "no")
+                      << ", oversized reserve rejected: " << (rejected ? "yes" : "no")
+                      << ", capacity kept: " << vec.capacity();
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test growth policies and shrink_to_fit
+            Verifies the capacity sequences of the 1.5x and linear policies, that shrink_to_fit
+            returns unused capacity and that a large mapped buffer keeps its data when it is
+            grown and shrunk by remapping
+        */
+        static void testGrowthPolicy()
+        {
+            auto capacities = [](const GrowthPolicy& policy)
+            {
+                Vector<int> vec;
+                vec.setGrowthPolicy(policy);
+                size_t last = 0;
+                for (int i = 0; i < 40; ++i)
+                {
+                    vec.push_back(i);
+                    if (vec.capacity() != last)
+                    {
+                        last = vec.capacity();
+                        std::cout << last << " ";
+                    }
+                }
+            };
+            std::cout << "testGrowthPolicy: 1.5x: ";
+            capacities(GrowthPolicy::oneAndHalf());
+            std::cout << "| linear past 32 bytes by 40 bytes: ";
+            capacities(GrowthPolicy::linearAfter(32, 40));
+
+            Vector<int> vec;
+            for (int i = 0; i < 100; ++i)
+                vec.push_back(i);
+            vec.resize(10);
+            vec.shrink_to_fit();
+            std::cout << "| shrunk capacity: " << vec.capacity() << ", back: " << vec.back();
+
+            bool rejected = false;
+            try
+            {
+                vec.setGrowthPolicy(GrowthPolicy{ 1, 1, 0, 0 });
+            }
+            catch (const char*)
+            {
+                rejected = true;
+            }
+            std::cout << ", invalid policy rejected: " << (rejected ? "yes" : "no");
+
+            Vector<double> large;
+            const size_t count = size_t(3) << 20;  // 24 MB, grown through several mappings
+            for (size_t i = 0; i < count; ++i)
+                large.push_back(static_cast<double>(i));
+            bool intact = large[12345] == 12345.0 && large.back() == static_cast<double>(count - 1);
+            large.resize(count / 2);
+            large.shrink_to_fit();
+            intact = intact && large.back() == static_cast<double>(count / 2 - 1);
+            std::cout << ", large buffer mapped: " << (large.pageBacking() != memory::PageBacking::Heap ? "yes" : "no")
+                      << ", data intact: " << (intact ? "yes" : "no");
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test incremental growth
+            Verifies that elements stay readable and in order while they move between buffers in batches
+        */
+        static void testIncrementalGrowth()
+        {
+            IncrementalVector<std::string> words;
+            words.setIncrementalGrowth(1);
+            for (int i = 0; i < 9; ++i)
+                words.push_back(std::to_string(i));
+            bool midway = words.migrating();  // 8 elements left behind by the growth to 16, 1 moved
+            std::string seen = words[1] + words[5] + words.back();
+            words.push_back(words[7]);        // Refers into the previous buffer
+            words.pop_back();
+            words.pop_back();
+
+            std::cout << "testIncrementalGrowth: migrating after growth: " << (midway ? "yes" : "no")
+                << ", reads during migration: " << seen << ", contents: ";
+            for (const std::string& word : words)
+                std::cout << word << " ";
+            std::cout << "| migrating after iteration: " << (words.migrating() ? "yes" : "no")
+                << ", plain Vector carries no migration state: " << (sizeof(Vector<int>) < sizeof(IncrementalVector<int>) ? "yes" : "no");
+
+            IncrementalVector<int> numbers;
+            numbers.setIncrementalGrowth(4);
+            bool finished = true;
+            for (int i = 0; i < 100000; ++i)
+            {
+                numbers.push_back(i);
+                finished = finished && !(numbers.size() == numbers.capacity() && numbers.migrating());
+            }
+            long long sum = 0;
+            for (size_t i = 0; i < numbers.size(); ++i)
+                sum += numbers[i];
+            std::cout << ", every migration done before the buffer filled: " << (finished ? "yes" : "no")
+                << ", sum: " << sum;
+
+            IncrementalVector<std::string> letters;
+            letters.setIncrementalGrowth(1);
+            for (char c = 'a'; c < 'i'; ++c)
+                letters.push_back(std::string(1, c));
+            std::istringstream input("X Y Z");
+            letters.insert(2, std::istream_iterator<std::string>(input), std::istream_iterator<std::string>());
+            std::cout << " | single-pass insert while growing: ";
+            for (const std::string& letter : letters)
+                std::cout << letter;
+            std::cout << "\n" << std::endl;
+        }
+
         /*
             Test accessors functionality
             Verifies that the elements of the vector can be accessed correctly
@@ -219,6 +484,53 @@ namespace mylib {
             std::cout << std::endl;
         }
 
+        /*
+            Test allocation from a memory resource
+            Verifies that a vector grows inside an arena and that moving it carries the arena along
+        */
+        static void testMemoryResource()
+        {
+            std::pmr::monotonic_buffer_resource arena;
+            Vector<int> vec(0, &arena);
+            for (int i = 1; i <= 5; ++i)
+                vec.push_back(i * i);
+            Vector<int> moved = static_cast<Vector<int>&&>(vec);
+
+            std::cout << "testMemoryResource: ";
+            printVector(moved);
+            std::cout << "moved uses arena: " << (moved.resource() == &arena ? "yes" : "no");
+            std::cout << "\n" << std::endl;
+        }
+
+        /*
+            Test interoperability with the standard algorithms
+            Verifies that the iterators are contiguous, that sorting, searching, reduction and
+            ranges algorithms run directly on a vector, and that reverse traversal stops at the first element
+        */
+        static void testStdAlgorithms()
+        {
+            static_assert(std::contiguous_iterator<Vector<int>::Iterator>);
+            static_assert(std::contiguous_iterator<Vector<int>::ConstIterator>);
+
+            Vector<int> vec;
+            const int values[] = { 42, -7, 19, 3, 88, 0, 15 };
+            vec.insert(0, values, values + 7);
+            std::sort(vec.begin(), vec.end());
+            const Vector<int>& view = vec;
+            auto found = std::lower_bound(view.begin(), view.end(), 15);
+            int total = std::reduce(vec.begin(), vec.end(), 0);
+            std::ranges::reverse(vec);
+
+            std::cout << "testStdAlgorithms: reversed sorted: ";
+            for (auto it = vec.begin(); it != vec.end(); ++it)
+                std::cout << *it << " ";
+            std::cout << "| lower_bound(15) at " << (found - view.begin()) << ", sum " << total
+                      << ", back to front: ";
+            for (auto it = vec.rbegin(); it != vec.rend(); --it)
+                std::cout << *it << " ";
+            std::cout << "\n" << std::endl;
+        }
+
         /*
             Test selection sort algorithm
             Verifies that the selection sort algorithm works correctly on the vector
@@ -1,9 +1,13 @@
-#include "TestVector.h"
-#include "TestArray.h"
-#include "TestMatrix.h"
-#include "TestList.h"
+#include "testVector.h"
+#include "testArray.h"
+#include "testMatrix.h"
+#include "testList.h"
 #include "testIntrusiveList.h"
 #include "testNDimVector.h"
+#include "testSmallVector.h"
+#include "testConcurrentVector.h"
+#include "testSegmentedVector.h"
+#include "testBitset.h"
 
 int main() {
     mylib::testVector::runTests(); 
@@ -12,5 +16,9 @@ int main() {
     mylib::testList::runTests();               
     mylib::testIntrusiveList::runTests();
     mylib::testNDimVector::runTests();
+    mylib::testSmallVector::runTests();
+    mylib::testConcurrentVector::runTests();
+    mylib::testSegmentedVector::runTests();
+    mylib::testBitset::runTests();
     return 0;
 }